@@ -5,27 +5,63 @@ CONFIG += console c++11
 CONFIG -= app_bundle
 CONFIG -= qt
 
+DEFINES += EULERIAN_INSTRUMENT
+
 SOURCES += \
+    allocator.c \
+    countingallocator.c \
+    arenaallocator.c \
     comparator.c \
     dlist.c \
     dlistiterator.c \
+    ulist.c \
+    ulistiterator.c \
     dlistnode.c \
+    dlistnodepool.c \
     edge.c \
     graph.c \
+    csrgraph.c \
+    edgelist.c \
+    unionfind.c \
+    outputwriter.c \
+    instrument.c \
+    hierholzer.c \
+    parallelcircuit.c \
+    eulerian.c \
+    batch.c \
+    server.c \
+    resultcache.c \
     main.c \
     path.c \
-    pathelement.c \
-    vertex.c
+    pathiterator.c \
+    pathelement.c
 
 HEADERS += \
     dlistnode.h \
+    dlistnodepool.h \
     basic.h \
+    allocator.h \
+    countingallocator.h \
+    arenaallocator.h \
     dlist.h \
     dlistiterator.h \
+    ulist.h \
+    ulistiterator.h \
     comparator.h \
     edge.h \
-    vertex.h \
     graph.h \
+    csrgraph.h \
+    edgelist.h \
+    unionfind.h \
+    outputwriter.h \
+    instrument.h \
+    hierholzer.h \
+    parallelcircuit.h \
+    eulerian.h \
+    batch.h \
+    server.h \
+    resultcache.h \
     path.h \
+    pathiterator.h \
     pathelement.h
 
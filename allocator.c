@@ -0,0 +1,89 @@
+#include "allocator.h"
+#include "string.h"
+
+
+// The default allocator has no state and doesn't need the sizes malloc keeps track of itself.
+static void *defaultAllocate( void *context, size_t size )
+{
+    (void) context;
+    return malloc( size );
+}
+
+
+static void *defaultReallocate( void *context, void *pointer, size_t oldSize, size_t newSize )
+{
+    (void) context;
+    (void) oldSize;
+    return realloc( pointer, newSize );
+}
+
+
+static void defaultRelease( void *context, void *pointer, size_t size )
+{
+    (void) context;
+    (void) size;
+    free( pointer );
+    return;
+}
+
+
+static const Allocator defaultAllocator = { defaultAllocate, defaultReallocate, defaultRelease, NULL };
+
+
+const Allocator *allocator_getDefault( void )
+{
+    return &defaultAllocator;
+}
+
+
+void *allocator_allocate( const Allocator *allocator, size_t size )
+{
+    if( allocator == NULL )
+        allocator = &defaultAllocator;
+
+    void *pointer = allocator->allocate( allocator->context, size );
+    assert( size == 0 || pointer != NULL );
+
+    return pointer;
+}
+
+
+void *allocator_reallocate( const Allocator *allocator, void *pointer, size_t oldSize, size_t newSize )
+{
+    if( allocator == NULL )
+        allocator = &defaultAllocator;
+
+    void *resized;
+    if( pointer == NULL )
+    {
+        resized = allocator->allocate( allocator->context, newSize );
+    }
+    else if( allocator->reallocate != NULL )
+    {
+        resized = allocator->reallocate( allocator->context, pointer, oldSize, newSize );
+    }
+    else
+    {
+        // The allocator can't resize, so we move the data to a new block.
+        resized = allocator->allocate( allocator->context, newSize );
+        if( resized != NULL )
+        {
+            memcpy( resized, pointer, oldSize < newSize ? oldSize : newSize );
+            allocator_release( allocator, pointer, oldSize );
+        }
+    }
+    assert( newSize == 0 || resized != NULL );
+
+    return resized;
+}
+
+
+void allocator_release( const Allocator *allocator, void *pointer, size_t size )
+{
+    if( allocator == NULL )
+        allocator = &defaultAllocator;
+
+    if( pointer != NULL && allocator->release != NULL )
+        allocator->release( allocator->context, pointer, size );
+    return;
+}
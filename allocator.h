@@ -0,0 +1,99 @@
+/**
+ * @file allocator.h
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief The interface through which graphs, paths and lists get their memory.
+ */
+
+
+#ifndef ALLOCATOR
+#define ALLOCATOR
+
+
+#include "basic.h"
+
+
+/**
+ * @brief A pointer to a function which returns a block of at least 'size' bytes or NULL if there's no memory left.
+ * The block must be aligned for any type.
+ */
+typedef void *(*AllocateFunction)( void *context, size_t size );
+
+
+/**
+ * @brief A pointer to a function which resizes a block. It keeps the first min( oldSize, newSize ) bytes
+ * and returns the (possibly moved) block or NULL if there's no memory left. The old block is still valid then.
+ */
+typedef void *(*ReallocateFunction)( void *context, void *pointer, size_t oldSize, size_t newSize );
+
+
+/**
+ * @brief A pointer to a function which gives back a block. 'size' is the size the block has been requested with.
+ */
+typedef void (*ReleaseFunction)( void *context, void *pointer, size_t size );
+
+
+/**
+ * @brief A table of memory functions and the context they work on.
+ *
+ * Every constructor of a graph or a path takes an allocator and passes it on to everything the object creates:
+ * vertices, edge arrays, lists, node pools and chunks. An object keeps a pointer to its allocator,
+ * so the allocator must outlive all objects which have been created with it.
+ *
+ * Blocks are always released with the size they've been requested with, so an allocator doesn't have to remember it.
+ */
+typedef struct
+{
+    AllocateFunction    allocate;       /**< Hands out a block. */
+    ReallocateFunction  reallocate;     /**< Resizes a block. If it is NULL, a new block is allocated and the data is copied. */
+    ReleaseFunction     release;        /**< Gives back a block. If it is NULL, blocks are never released one by one. */
+    void *              context;        /**< Passed to every function, e.g. the state of the allocator. */
+} Allocator;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @return The allocator which uses malloc, realloc and free. It is used whenever no allocator is given.
+ */
+const Allocator *allocator_getDefault( void );
+
+
+/**
+ * @brief Allocates a block and asserts that this has worked.
+ * @param allocator The allocator or NULL for the default allocator.
+ * @param size
+ * @return The pointer to the block. It may be NULL if the size is 0.
+ */
+void *allocator_allocate( const Allocator *allocator, size_t size );
+
+
+/**
+ * @brief Resizes a block and asserts that this has worked.
+ * @param allocator The allocator or NULL for the default allocator.
+ * @param pointer The block or NULL to allocate a new one.
+ * @param oldSize The size the block has been requested with (0 if the pointer is NULL).
+ * @param newSize
+ * @return The pointer to the resized block.
+ */
+void *allocator_reallocate( const Allocator *allocator, void *pointer, size_t oldSize, size_t newSize );
+
+
+/**
+ * @brief Gives back a block. Nothing happens if the pointer is NULL.
+ * @param allocator The allocator or NULL for the default allocator.
+ * @param pointer
+ * @param size The size the block has been requested with.
+ */
+void allocator_release( const Allocator *allocator, void *pointer, size_t size );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // ALLOCATOR
@@ -0,0 +1,256 @@
+#include "arenaallocator.h"
+#include "string.h"
+#include "stdint.h"
+#include "sys/mman.h"
+
+
+/**
+ * @brief Rounds a size up to the alignment of the arena. Even empty requests take some room, so every pointer is unique.
+ */
+static size_t alignSize( size_t size )
+{
+    if( size == 0 )
+        return ARENAALLOCATOR_ALIGNMENT;
+
+    return ( size + ARENAALLOCATOR_ALIGNMENT - 1 ) / ARENAALLOCATOR_ALIGNMENT * ARENAALLOCATOR_ALIGNMENT;
+}
+
+
+/**
+ * @brief Rounds the size of a block including its header up to whole huge pages.
+ * @return The size of the block without its header.
+ */
+static size_t hugePageBlockSize( size_t size )
+{
+    size_t mappedSize = ( sizeof( ArenaBlock ) + size + ARENAALLOCATOR_HUGE_PAGE_SIZE - 1 ) & ~( ARENAALLOCATOR_HUGE_PAGE_SIZE - 1 );
+    return mappedSize - sizeof( ArenaBlock );
+}
+
+
+/**
+ * @brief Maps a block of whole huge pages which starts at a huge page boundary.
+ */
+static ArenaBlock *mapBlock( size_t mappedSize )
+{
+    // Map one huge page more than needed, so the block can be moved to the next boundary.
+    size_t paddedSize = mappedSize + ARENAALLOCATOR_HUGE_PAGE_SIZE;
+    char *mapped = (char *) mmap( NULL, paddedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    assert( mapped != MAP_FAILED );
+
+    char *start = (char *) ( ( (uintptr_t) mapped + ARENAALLOCATOR_HUGE_PAGE_SIZE - 1 ) & ~(uintptr_t) ( ARENAALLOCATOR_HUGE_PAGE_SIZE - 1 ));
+
+    // Give back what's in front of and behind the block.
+    if( start > mapped )
+        munmap( mapped, start - mapped );
+    if( mapped + paddedSize > start + mappedSize )
+        munmap( start + mappedSize, mapped + paddedSize - ( start + mappedSize ));
+
+    // This is only advice: without transparent huge pages, the block simply uses ordinary pages.
+#ifdef MADV_HUGEPAGE
+    madvise( start, mappedSize, MADV_HUGEPAGE );
+#endif
+
+    return (ArenaBlock *) start;
+}
+
+
+/**
+ * @brief Takes a new block from the parent or the system. It isn't linked into the arena yet.
+ */
+static ArenaBlock *newBlock( ArenaAllocator *arena, size_t size )
+{
+    ArenaBlock *block;
+    if( arena->hugePages )
+    {
+        size = hugePageBlockSize( size );
+        block = mapBlock( sizeof( ArenaBlock ) + size );
+    }
+    else
+    {
+        block = (ArenaBlock *) allocator_allocate( arena->parent, sizeof( ArenaBlock ) + size );
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    arena->totalBytes += size;
+
+    return block;
+}
+
+
+/**
+ * @brief Gives a block back to the parent or the system.
+ */
+static void releaseBlock( ArenaAllocator *arena, ArenaBlock *block )
+{
+    arena->totalBytes -= block->size;
+
+    if( arena->hugePages )
+        munmap( block, sizeof( ArenaBlock ) + block->size );
+    else
+        allocator_release( arena->parent, block, sizeof( ArenaBlock ) + block->size );
+    return;
+}
+
+
+static void *arenaAllocate( void *context, size_t size )
+{
+    ArenaAllocator *arena = (ArenaAllocator *) context;
+    size_t alignedSize = alignSize( size );
+
+    ArenaBlock *block = arena->blocks;
+    if( block == NULL || block->size - block->used < alignedSize )
+    {
+        // A large request gets a block of its own behind the current one, so the rest of the current block isn't wasted.
+        if( block != NULL && alignedSize > arena->blockSize )
+        {
+            ArenaBlock *largeBlock = newBlock( arena, alignedSize );
+            largeBlock->used = alignedSize;
+            largeBlock->next = block->next;
+            block->next = largeBlock;
+            return largeBlock->data;
+        }
+
+        block = newBlock( arena, alignedSize > arena->blockSize ? alignedSize : arena->blockSize );
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void *pointer = block->data + block->used;
+    block->used += alignedSize;
+    arena->lastPointer = pointer;
+
+    return pointer;
+}
+
+
+static void *arenaReallocate( void *context, void *pointer, size_t oldSize, size_t newSize )
+{
+    ArenaAllocator *arena = (ArenaAllocator *) context;
+
+    // The most recent allocation can grow or shrink in place as long as it fits into its block.
+    if( pointer == arena->lastPointer )
+    {
+        ArenaBlock *block = arena->blocks;
+        size_t offset = (char *) pointer - block->data;
+        if( block->size - offset >= alignSize( newSize ))
+        {
+            block->used = offset + alignSize( newSize );
+            return pointer;
+        }
+    }
+
+    void *resized = arenaAllocate( arena, newSize );
+    memcpy( resized, pointer, oldSize < newSize ? oldSize : newSize );
+
+    return resized;
+}
+
+
+static void arenaRelease( void *context, void *pointer, size_t size )
+{
+    ArenaAllocator *arena = (ArenaAllocator *) context;
+    (void) size;
+
+    // Only the most recent allocation can be taken back. Everything else waits for the arena to be reset.
+    if( pointer == arena->lastPointer )
+    {
+        arena->blocks->used = (char *) pointer - arena->blocks->data;
+        arena->lastPointer = NULL;
+    }
+    return;
+}
+
+
+ArenaAllocator *arenaAllocator_new( const Allocator *parent, size_t blockSize )
+{
+    ArenaAllocator *arena = (ArenaAllocator *) malloc( sizeof( ArenaAllocator ));
+    assert( arena != NULL );
+
+    arena->allocator.allocate = arenaAllocate;
+    arena->allocator.reallocate = arenaReallocate;
+    arena->allocator.release = arenaRelease;
+    arena->allocator.context = arena;
+
+    arena->parent = parent != NULL ? parent : allocator_getDefault();
+    arena->blockSize = alignSize( blockSize > 0 ? blockSize : ARENAALLOCATOR_DEFAULT_BLOCK_SIZE );
+    arena->blocks = NULL;
+    arena->lastPointer = NULL;
+    arena->totalBytes = 0;
+    arena->hugePages = false;
+
+    return arena;
+}
+
+
+ArenaAllocator *arenaAllocator_newWithHugePages( size_t blockSize )
+{
+    ArenaAllocator *arena = arenaAllocator_new( NULL, blockSize );
+    arena->hugePages = true;
+
+    // Regular blocks fill their huge pages completely.
+    arena->blockSize = hugePageBlockSize( arena->blockSize );
+
+    return arena;
+}
+
+
+/**
+ * @brief Gives back the chain of blocks which starts with the given one.
+ */
+static void releaseBlocks( ArenaAllocator *arena, ArenaBlock *block )
+{
+    while( block != NULL )
+    {
+        ArenaBlock *next = block->next;
+        releaseBlock( arena, block );
+        block = next;
+    }
+    return;
+}
+
+
+void arenaAllocator_destroy( ArenaAllocator *arena )
+{
+    releaseBlocks( arena, arena->blocks );
+    free( arena );
+    return;
+}
+
+
+void arenaAllocator_reset( ArenaAllocator *arena )
+{
+    ArenaBlock *block = arena->blocks;
+    arena->lastPointer = NULL;
+
+    if( block == NULL )
+        return;
+
+    // Keep the current block if it has the usual size, so an arena which is reset for every graph
+    // doesn't have to ask its parent or the system for the first block again.
+    if( block->size == arena->blockSize )
+    {
+        releaseBlocks( arena, block->next );
+        block->next = NULL;
+        block->used = 0;
+    }
+    else
+    {
+        releaseBlocks( arena, block );
+        arena->blocks = NULL;
+    }
+    return;
+}
+
+
+const Allocator *arenaAllocator_get( ArenaAllocator *arena )
+{
+    return &arena->allocator;
+}
+
+
+size_t arenaAllocator_getTotalBytes( ArenaAllocator *arena )
+{
+    return arena->totalBytes;
+}
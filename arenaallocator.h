@@ -0,0 +1,135 @@
+/**
+ * @file arenaallocator.h
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief An allocator which hands out memory by bumping a pointer through large blocks.
+ */
+
+
+#ifndef ARENAALLOCATOR
+#define ARENAALLOCATOR
+
+
+#include "allocator.h"
+
+
+/**
+ * @brief The number of bytes an arena allocates at once if no block size is given.
+ */
+#define ARENAALLOCATOR_DEFAULT_BLOCK_SIZE   ( 1 << 20 )
+
+
+/**
+ * @brief Every block an arena hands out starts at a multiple of this.
+ */
+#define ARENAALLOCATOR_ALIGNMENT            16
+
+
+/**
+ * @brief The size of a huge page. Arenas with huge pages map their blocks in multiples of it.
+ */
+#define ARENAALLOCATOR_HUGE_PAGE_SIZE       ( (size_t) 2 << 20 )
+
+
+typedef struct ArenaBlock ArenaBlock;
+
+/**
+ * @brief A block of memory of an arena. The blocks are chained so they can be released in one go.
+ */
+struct ArenaBlock
+{
+    ArenaBlock *    next;       /**< The block which has been allocated before this one. */
+    size_t          size;       /**< The number of bytes behind the header. */
+    size_t          used;       /**< The number of bytes which have been handed out so far. */
+    size_t          padding;    /**< Keeps the data aligned to ARENAALLOCATOR_ALIGNMENT. */
+    char            data[];     /**< The memory which is handed out. */
+};
+
+
+/**
+ * @brief A bump allocator.
+ *
+ * Allocating just moves a pointer forward, and releasing does nothing unless the block is the most recent one.
+ * All memory is given back at once when the arena is reset or destroyed,
+ * so a graph or a path which lives in an arena doesn't have to be destroyed piece by piece:
+ * tearing it down takes one call per block instead of one per edge array and node.
+ * Resizing the most recent block grows it in place if there's room.
+ *
+ * An arena is not synchronized: it must not be shared by several threads.
+ */
+typedef struct
+{
+    Allocator           allocator;      /**< The functions which work on the arena. Its context is the arena. */
+    const Allocator *   parent;         /**< The allocator the blocks are taken from, unless they're mapped. */
+    size_t              blockSize;      /**< The usual size of a block. Larger requests get a block of their own. */
+    ArenaBlock *        blocks;         /**< The most recently allocated block. */
+    void *              lastPointer;    /**< The most recently handed out memory or NULL. */
+    size_t              totalBytes;     /**< The number of bytes in all blocks. */
+    bool                hugePages;      /**< true, if the blocks are mapped from the system and advised to use huge pages. */
+} ArenaAllocator;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new arena. No block is allocated until memory is requested.
+ * @param parent The allocator to take the blocks from or NULL for the default allocator.
+ * @param blockSize The number of bytes to allocate at once or 0 for ARENAALLOCATOR_DEFAULT_BLOCK_SIZE.
+ * @return The pointer to the new arena.
+ */
+ArenaAllocator *arenaAllocator_new( const Allocator *parent, size_t blockSize );
+
+
+/**
+ * @brief Allocates and initializes a new arena whose blocks are mapped from the system instead of taken from an allocator.
+ * Every block starts at a huge page boundary, spans whole huge pages and is advised to be backed by huge pages
+ * (madvise with MADV_HUGEPAGE), so walking a large graph needs far fewer TLB entries.
+ * Where the system doesn't support this, the blocks are mapped with ordinary pages.
+ * @param blockSize The number of bytes to allocate at once or 0 for ARENAALLOCATOR_DEFAULT_BLOCK_SIZE.
+ * It is rounded up to whole huge pages.
+ * @return The pointer to the new arena.
+ */
+ArenaAllocator *arenaAllocator_newWithHugePages( size_t blockSize );
+
+
+/**
+ * @brief Gives back all blocks and frees the arena.
+ * @param arena
+ *
+ * @attention Everything which has been allocated from the arena is invalid afterwards!
+ */
+void arenaAllocator_destroy( ArenaAllocator *arena );
+
+
+/**
+ * @brief Gives back all blocks but one, so the arena can be used again. The kept block is used from its start.
+ * @param arena
+ *
+ * @attention Everything which has been allocated from the arena is invalid afterwards!
+ */
+void arenaAllocator_reset( ArenaAllocator *arena );
+
+
+/**
+ * @param arena
+ * @return The allocator to pass to the constructors.
+ */
+const Allocator *arenaAllocator_get( ArenaAllocator *arena );
+
+
+/**
+ * @param arena
+ * @return The number of bytes in the blocks the arena holds right now.
+ */
+size_t arenaAllocator_getTotalBytes( ArenaAllocator *arena );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // ARENAALLOCATOR
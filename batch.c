@@ -0,0 +1,298 @@
+#include "batch.h"
+#include "eulerian.h"
+#include "string.h"
+#include "pthread.h"
+#include "dirent.h"
+#include "sys/stat.h"
+
+
+/**
+ * @brief One graph file and, once a worker is done with it, its result.
+ */
+typedef struct
+{
+    char *          filename;       /**< The graph file. */
+    EulerianStatus  status;         /**< The result of loading and solving. */
+    int *           vertices;       /**< The eulerian path if the status is EULERIAN_OK. */
+    size_t          length;         /**< The number of vertex numbers of the path. */
+    int             errorLine;      /**< The line of a format error or 0. */
+    int             errorColumn;    /**< The column of a format error or 0. */
+    const char *    errorMessage;   /**< Why the file couldn't be loaded. */
+    bool            done;           /**< true, if the result is ready. Protected by the mutex of the batch. */
+} BatchJob;
+
+
+/**
+ * @brief The state which the worker threads share.
+ */
+typedef struct
+{
+    BatchJob *      jobs;           /**< The files in input order. */
+    size_t          jobCount;       /**< The number of files. */
+    size_t          nextJob;        /**< The first file which no worker has taken yet. */
+    pthread_mutex_t mutex;          /**< Protects nextJob and the done flags. */
+    pthread_cond_t  jobDone;        /**< Signaled whenever a job is done. */
+    EulerianMemory  memory;         /**< Where the solvers keep their graphs. */
+} Batch;
+
+
+/**
+ * @brief Appends a filename to the jobs and doubles the array if it is full.
+ */
+static void addJob( Batch *batch, size_t *capacity, char *filename )
+{
+    if( batch->jobCount == *capacity )
+    {
+        *capacity = *capacity > 0 ? 2 * *capacity : 64;
+        batch->jobs = (BatchJob *) realloc( batch->jobs, *capacity * sizeof( BatchJob ));
+        assert( batch->jobs != NULL );
+    }
+
+    BatchJob *job = &batch->jobs[ batch->jobCount++ ];
+    memset( job, 0, sizeof( BatchJob ));
+    job->filename = filename;
+    return;
+}
+
+
+/**
+ * @brief Joins a directory and a name with a slash.
+ */
+static char *joinPath( const char *directory, const char *name )
+{
+    size_t directoryLength = strlen( directory );
+    size_t nameLength = strlen( name );
+
+    char *path = (char *) malloc( directoryLength + nameLength + 2 );
+    assert( path != NULL );
+
+    memcpy( path, directory, directoryLength );
+    path[ directoryLength ] = '/';
+    memcpy( path + directoryLength + 1, name, nameLength + 1 );
+
+    return path;
+}
+
+
+/**
+ * @brief Adds all regular files of a directory, sorted by name.
+ */
+static bool readDirectory( Batch *batch, const char *directory )
+{
+    struct dirent **entries;
+    int entryCount = scandir( directory, &entries, NULL, alphasort );
+    if( entryCount < 0 )
+        return false;
+
+    size_t capacity = 0;
+    int entryNum;
+    for( entryNum = 0; entryNum < entryCount; entryNum++ )
+    {
+        char *path = joinPath( directory, entries[ entryNum ]->d_name );
+
+        struct stat fileStat;
+        if( stat( path, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ))
+            addJob( batch, &capacity, path );
+        else
+            free( path );
+
+        free( entries[ entryNum ] );
+    }
+
+    free( entries );
+    return true;
+}
+
+
+/**
+ * @brief Adds every non-empty line of a manifest as a filename.
+ */
+static bool readManifest( Batch *batch, const char *manifest )
+{
+    FILE *file = fopen( manifest, "r" );
+    if( file == NULL )
+        return false;
+
+    size_t capacity = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    ssize_t lineLength;
+    while(( lineLength = getline( &line, &lineCapacity, file )) >= 0 )
+    {
+        // Strip the line break, including the one of Windows.
+        while( lineLength > 0 && ( line[ lineLength - 1 ] == '\n' || line[ lineLength - 1 ] == '\r' ))
+            line[ --lineLength ] = '\0';
+
+        if( lineLength > 0 )
+            addJob( batch, &capacity, strdup( line ));
+    }
+
+    free( line );
+    fclose( file );
+    return true;
+}
+
+
+/**
+ * @brief Loads and solves one file with the solver of the worker.
+ */
+static void solveJob( EulerianSolver *solver, BatchJob *job )
+{
+    job->status = eulerianSolver_loadFile( solver, job->filename );
+    if( job->status != EULERIAN_OK )
+    {
+        job->errorMessage = eulerianSolver_getError( solver, &job->errorLine, &job->errorColumn );
+        return;
+    }
+
+    size_t length = eulerianSolver_getPathLength( solver );
+    job->vertices = (int *) malloc(( length > 0 ? length : 1 ) * sizeof( int ));
+    assert( job->vertices != NULL );
+
+    job->status = eulerianSolver_solve( solver, job->vertices, length, &job->length );
+    return;
+}
+
+
+/**
+ * @brief The loop of a worker thread: take the next file until there is none left.
+ */
+static void *batch_work( void *argument )
+{
+    Batch *batch = (Batch *) argument;
+    EulerianSolver *solver = eulerianSolver_new();
+    eulerianSolver_setMemory( solver, batch->memory );
+
+    while( true )
+    {
+        pthread_mutex_lock( &batch->mutex );
+        size_t jobNum = batch->nextJob;
+        if( jobNum < batch->jobCount )
+            batch->nextJob++;
+        pthread_mutex_unlock( &batch->mutex );
+
+        if( jobNum >= batch->jobCount )
+            break;
+
+        BatchJob *job = &batch->jobs[ jobNum ];
+        solveJob( solver, job );
+
+        pthread_mutex_lock( &batch->mutex );
+        job->done = true;
+        pthread_cond_broadcast( &batch->jobDone );
+        pthread_mutex_unlock( &batch->mutex );
+    }
+
+    eulerianSolver_destroy( solver );
+    return NULL;
+}
+
+
+/**
+ * @brief Writes the result line of a job. It looks like the output of a single run, prefixed with the filename.
+ */
+static void writeJob( OutputWriter *output, BatchJob *job )
+{
+    outputWriter_writeString( output, job->filename );
+    outputWriter_writeString( output, ": " );
+
+    if( job->status == EULERIAN_OK )
+    {
+        size_t position;
+        for( position = 0; position < job->length; position++ )
+        {
+            outputWriter_writeInt( output, job->vertices[ position ] );
+            outputWriter_writeChar( output, ' ' );
+        }
+    }
+    else if( job->status == EULERIAN_NO_PATH )
+    {
+        outputWriter_writeString( output, "-1" );
+    }
+    else if( job->status == EULERIAN_UNREADABLE_FILE )
+    {
+        // The same message as a single run, so a missing file can be told apart from one with bad content.
+        outputWriter_writeString( output, "Konnte " );
+        outputWriter_writeString( output, job->filename );
+        outputWriter_writeString( output, " nicht lesen" );
+    }
+    else
+    {
+        outputWriter_writeString( output, "Ungueltiges Eingabeformat" );
+        if( job->errorLine > 0 )
+        {
+            outputWriter_writeString( output, " (Zeile " );
+            outputWriter_writeInt( output, job->errorLine );
+            outputWriter_writeString( output, ", Spalte " );
+            outputWriter_writeInt( output, job->errorColumn );
+            outputWriter_writeString( output, ": " );
+            outputWriter_writeString( output, job->errorMessage );
+            outputWriter_writeChar( output, ')' );
+        }
+    }
+
+    outputWriter_writeChar( output, '\n' );
+    return;
+}
+
+
+bool batch_run( const char *source, int threadCount, EulerianMemory memory, OutputWriter *output )
+{
+    Batch batch;
+    batch.jobs = NULL;
+    batch.jobCount = 0;
+    batch.nextJob = 0;
+    batch.memory = memory;
+
+    // The source is either a directory or a manifest.
+    struct stat sourceStat;
+    if( stat( source, &sourceStat ) != 0 )
+        return false;
+
+    bool listed = S_ISDIR( sourceStat.st_mode ) ? readDirectory( &batch, source ) : readManifest( &batch, source );
+    if( !listed )
+        return false;
+
+    // There's no point in more workers than files.
+    if( threadCount < 1 )
+        threadCount = 1;
+    if( (size_t) threadCount > batch.jobCount )
+        threadCount = batch.jobCount > 0 ? (int) batch.jobCount : 1;
+
+    pthread_mutex_init( &batch.mutex, NULL );
+    pthread_cond_init( &batch.jobDone, NULL );
+
+    pthread_t *threads = (pthread_t *) malloc( threadCount * sizeof( pthread_t ));
+    assert( threads != NULL );
+
+    int threadNum;
+    for( threadNum = 0; threadNum < threadCount; threadNum++ )
+        pthread_create( &threads[ threadNum ], NULL, batch_work, &batch );
+
+    // Write the results in input order while the workers go on. A result is freed right after it's written.
+    size_t jobNum;
+    for( jobNum = 0; jobNum < batch.jobCount; jobNum++ )
+    {
+        BatchJob *job = &batch.jobs[ jobNum ];
+
+        pthread_mutex_lock( &batch.mutex );
+        while( !job->done )
+            pthread_cond_wait( &batch.jobDone, &batch.mutex );
+        pthread_mutex_unlock( &batch.mutex );
+
+        writeJob( output, job );
+
+        free( job->vertices );
+        free( job->filename );
+    }
+
+    for( threadNum = 0; threadNum < threadCount; threadNum++ )
+        pthread_join( threads[ threadNum ], NULL );
+
+    free( threads );
+    free( batch.jobs );
+    pthread_cond_destroy( &batch.jobDone );
+    pthread_mutex_destroy( &batch.mutex );
+
+    return true;
+}
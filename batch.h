@@ -0,0 +1,47 @@
+/**
+ * @file batch.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief Solves many graph files in one process with a pool of worker threads.
+ */
+
+
+#ifndef BATCH
+#define BATCH
+
+
+#include "basic.h"
+#include "outputwriter.h"
+#include "eulerian.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Solves every graph file of a manifest or a directory and writes one line per file in input order.
+ *
+ * A manifest is a text file with one graph filename per line. Empty lines are skipped.
+ * A directory is solved file by file in the order of their names.
+ * Each line starts with the filename and a colon, followed by the vertex numbers of the eulerian path,
+ * "-1" if there is none, or the reason why the file couldn't be loaded.
+ *
+ * Every worker thread has an EulerianSolver of its own, so the working memory of the solver
+ * is reused for all files the thread solves. The results are written as soon as all files before them are done.
+ * @param source The manifest or the directory.
+ * @param threadCount The number of worker threads.
+ * @param memory Where the solvers keep their graphs. In an arena, a graph is released at once when the next file is loaded.
+ * @param output The writer which receives the results.
+ * @return false, if the manifest or directory couldn't be read.
+ */
+bool batch_run( const char *source, int threadCount, EulerianMemory memory, OutputWriter *output );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // BATCH
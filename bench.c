@@ -0,0 +1,545 @@
+/**
+ * @file bench.c
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief Measures every phase of the program on synthetic graphs and prints one JSON line per graph and engine.
+ *
+ * The graphs are generated as text files in memory with a fixed seed, so every build measures exactly the same input.
+ * Each graph is solved by each engine in a child process of its own, which starts from the same state
+ * and reports its own peak memory.
+ */
+
+
+#include "string.h"
+#include "unistd.h"
+#include "time.h"
+#include "stdint.h"
+#include "sys/resource.h"
+#include "sys/wait.h"
+#include "basic.h"
+#include "graph.h"
+#include "path.h"
+#include "pathelement.h"
+#include "pathiterator.h"
+#include "edgelist.h"
+#include "outputwriter.h"
+#include "hierholzer.h"
+#include "parallelcircuit.h"
+#include "arenaallocator.h"
+#include "eulerian.h"
+
+
+/**
+ * @brief The number of edge pairs each graph has about, unless '-s' says otherwise.
+ */
+#define BENCH_DEFAULT_EDGE_COUNT    ( 1 << 20 )
+
+
+/**
+ * @brief A graph file which is written into memory.
+ */
+typedef struct
+{
+    char *      text;           /**< The file content. */
+    size_t      size;           /**< The number of bytes written. */
+    size_t      capacity;       /**< The number of bytes which fit into the buffer. */
+    int         vertexCount;    /**< The number of vertices. */
+    size_t      edgeCount;      /**< The number of edge pairs written. */
+    uint64_t    random;         /**< The state of the random number generator. */
+} GraphText;
+
+
+/**
+ * @brief Writes a graph family with about edgeCount edge pairs.
+ */
+typedef void (*Generator)( GraphText *graphText, size_t edgeCount );
+
+
+/**
+ * @brief A graph family and the result every correct engine must find for it.
+ */
+typedef struct
+{
+    const char *    name;
+    Generator       generate;
+    bool            hasPath;        /**< true, if the family has an eulerian cycle or path. */
+} Family;
+
+
+/**
+ * @brief An engine as selected by the options of the program.
+ */
+typedef struct
+{
+    const char *    name;
+    Engine          engine;
+    ListBackend     listBackend;    /**< Only used by ENGINE_LIST_MERGING. */
+} BenchEngine;
+
+
+/**
+ * @brief The wall times of the phases of one run, in seconds.
+ */
+typedef struct
+{
+    double  parse;      /**< Parsing the text into an edge list. */
+    double  build;      /**< Creating the graph from the edge list. */
+    double  check;      /**< Checking the vertex degrees. */
+    double  solve;      /**< Finding the cycle or path. */
+    double  print;      /**< Writing the result. */
+    double  teardown;   /**< Destroying the graph, the path and the circuit. */
+} PhaseTimes;
+
+
+/**
+ * @brief The names of the memory modes in the JSON lines, indexed by EulerianMemory.
+ */
+static const char *memoryNames[] = { "heap", "arena", "huge_pages" };
+
+
+static double now( void )
+{
+    struct timespec time;
+    clock_gettime( CLOCK_MONOTONIC, &time );
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * @brief xorshift64*, which is fast and the same on every machine.
+ */
+static uint64_t nextRandom( GraphText *graphText )
+{
+    graphText->random ^= graphText->random >> 12;
+    graphText->random ^= graphText->random << 25;
+    graphText->random ^= graphText->random >> 27;
+    return graphText->random * 0x2545F4914F6CDD1DULL;
+}
+
+
+static void graphText_init( GraphText *graphText, int vertexCount, size_t edgeCount )
+{
+    // Two numbers of up to ten digits, a space and a line break per edge pair.
+    graphText->capacity = 16 + edgeCount * 24;
+    graphText->text = (char *) malloc( graphText->capacity );
+    assert( graphText->text != NULL );
+
+    graphText->vertexCount = vertexCount;
+    graphText->edgeCount = 0;
+    graphText->random = 0x9E3779B97F4A7C15ULL;
+    graphText->size = (size_t) sprintf( graphText->text, "%d\n", vertexCount );
+    return;
+}
+
+
+static void graphText_appendInt( GraphText *graphText, int number )
+{
+    char digits[ 12 ];
+    int digitCount = 0;
+    do
+    {
+        digits[ digitCount++ ] = (char) ( '0' + number % 10 );
+        number /= 10;
+    }
+    while( number > 0 );
+
+    while( digitCount > 0 )
+        graphText->text[ graphText->size++ ] = digits[ --digitCount ];
+
+    return;
+}
+
+
+static void graphText_addEdgePair( GraphText *graphText, int vertexNum1, int vertexNum2 )
+{
+    assert( graphText->size + 24 <= graphText->capacity );
+
+    graphText_appendInt( graphText, vertexNum1 );
+    graphText->text[ graphText->size++ ] = ' ';
+    graphText_appendInt( graphText, vertexNum2 );
+    graphText->text[ graphText->size++ ] = '\n';
+    graphText->edgeCount++;
+    return;
+}
+
+
+/**
+ * @brief One cycle through all vertices in order.
+ */
+static void generateCycle( GraphText *graphText, size_t edgeCount )
+{
+    int vertexCount = (int) edgeCount;
+    graphText_init( graphText, vertexCount, edgeCount );
+
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+        graphText_addEdgePair( graphText, vertexNum, ( vertexNum + 1 ) % vertexCount );
+
+    return;
+}
+
+
+/**
+ * @brief A square grid whose borders wrap around, so every vertex has four neighbors.
+ */
+static void generateGrid( GraphText *graphText, size_t edgeCount )
+{
+    int side = 3;
+    while( 2 * (size_t) ( side + 1 ) * ( side + 1 ) <= edgeCount )
+        side++;
+
+    graphText_init( graphText, side * side, 2 * (size_t) side * side );
+
+    int row, column;
+    for( row = 0; row < side; row++ )
+    {
+        for( column = 0; column < side; column++ )
+        {
+            int vertexNum = row * side + column;
+            graphText_addEdgePair( graphText, vertexNum, row * side + ( column + 1 ) % side );
+            graphText_addEdgePair( graphText, vertexNum, (( row + 1 ) % side ) * side + column );
+        }
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Two cycles through all vertices in random orders. Every vertex has degree four, and a vertex may
+ * have two edges to the same neighbor.
+ */
+static void generateRandom( GraphText *graphText, size_t edgeCount )
+{
+    int vertexCount = (int) ( edgeCount / 2 );
+    graphText_init( graphText, vertexCount, 2 * (size_t) vertexCount );
+
+    int *order = (int *) malloc( vertexCount * sizeof( int ));
+    assert( order != NULL );
+
+    int round;
+    for( round = 0; round < 2; round++ )
+    {
+        // Fisher-Yates shuffle.
+        int position;
+        for( position = 0; position < vertexCount; position++ )
+            order[ position ] = position;
+        for( position = vertexCount - 1; position > 0; position-- )
+        {
+            int other = (int) ( nextRandom( graphText ) % (uint64_t) ( position + 1 ));
+            int swap = order[ position ];
+            order[ position ] = order[ other ];
+            order[ other ] = swap;
+        }
+
+        for( position = 0; position < vertexCount; position++ )
+            graphText_addEdgePair( graphText, order[ position ], order[ ( position + 1 ) % vertexCount ] );
+    }
+
+    free( order );
+    return;
+}
+
+
+/**
+ * @brief The complete graph with an odd number of vertices, so every degree is even.
+ */
+static void generateComplete( GraphText *graphText, size_t edgeCount )
+{
+    int vertexCount = 3;
+    while( (size_t) ( vertexCount + 2 ) * ( vertexCount + 1 ) / 2 <= edgeCount )
+        vertexCount += 2;
+
+    graphText_init( graphText, vertexCount, (size_t) vertexCount * ( vertexCount - 1 ) / 2 );
+
+    int vertexNum1, vertexNum2;
+    for( vertexNum1 = 0; vertexNum1 < vertexCount; vertexNum1++ )
+        for( vertexNum2 = vertexNum1 + 1; vertexNum2 < vertexCount; vertexNum2++ )
+            graphText_addEdgePair( graphText, vertexNum1, vertexNum2 );
+
+    return;
+}
+
+
+/**
+ * @brief Triangles which all share vertex 0, so that one vertex has almost all edges.
+ */
+static void generateHub( GraphText *graphText, size_t edgeCount )
+{
+    int triangleCount = (int) ( edgeCount / 3 );
+    graphText_init( graphText, 2 * triangleCount + 1, 3 * (size_t) triangleCount );
+
+    int triangleNum;
+    for( triangleNum = 0; triangleNum < triangleCount; triangleNum++ )
+    {
+        int spokeNum = 2 * triangleNum + 1;
+        graphText_addEdgePair( graphText, 0, spokeNum );
+        graphText_addEdgePair( graphText, spokeNum, spokeNum + 1 );
+        graphText_addEdgePair( graphText, spokeNum + 1, 0 );
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Two cycles without a common vertex. All degrees are even, but there's no eulerian cycle.
+ */
+static void generateDisconnected( GraphText *graphText, size_t edgeCount )
+{
+    int half = (int) ( edgeCount / 2 );
+    graphText_init( graphText, 2 * half, 2 * (size_t) half );
+
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < half; vertexNum++ )
+    {
+        graphText_addEdgePair( graphText, vertexNum, ( vertexNum + 1 ) % half );
+        graphText_addEdgePair( graphText, half + vertexNum, half + ( vertexNum + 1 ) % half );
+    }
+
+    return;
+}
+
+
+static const Family families[] =
+{
+    { "cycle",          generateCycle,          true },
+    { "grid",           generateGrid,           true },
+    { "random",         generateRandom,         true },
+    { "complete",       generateComplete,       true },
+    { "hub",            generateHub,            true },
+    { "disconnected",   generateDisconnected,   false }
+};
+
+
+static const BenchEngine engines[] =
+{
+    { "list",           ENGINE_LIST_MERGING,    LIST_BACKEND_LINKED },
+    { "unrolled",       ENGINE_LIST_MERGING,    LIST_BACKEND_UNROLLED },
+    { "iterative",      ENGINE_ITERATIVE,       LIST_BACKEND_LINKED },
+    { "nondestructive", ENGINE_NON_DESTRUCTIVE, LIST_BACKEND_LINKED },
+    { "parallel",       ENGINE_PARALLEL,        LIST_BACKEND_LINKED }
+};
+
+
+/**
+ * @brief Loads, checks, solves and prints a graph like the program does, and measures each phase.
+ * The result goes to /dev/null, so only formatting and writing are measured.
+ * @return true, if a cycle or path was found.
+ */
+static bool runPhases( GraphText *graphText, const BenchEngine *engine, int threadCount, EulerianMemory memory, PhaseTimes *times )
+{
+    ArenaAllocator *arena = NULL;
+    if( memory == EULERIAN_MEMORY_HUGE_PAGES )
+        arena = arenaAllocator_newWithHugePages( 0 );
+    else if( memory == EULERIAN_MEMORY_ARENA )
+        arena = arenaAllocator_new( NULL, 0 );
+
+    double start = now();
+    EdgeListError error;
+    EdgeList *edgeList = edgeList_parse( graphText->text, graphText->size, 1, &error );
+    assert( edgeList != NULL );
+
+    double parsed = now();
+    Graph *graph = graph_newWithAllocator( edgeList->vertexCount, arena != NULL ? arenaAllocator_get( arena ) : NULL );
+    graph_addEdgePairs( graph, edgeList->edgePairs, edgeList->edgePairCount );
+    edgeList_destroy( edgeList );
+
+    double built = now();
+    GraphInformation graphInfo = checkVertexDegrees( graph, NULL );
+    bool proceed = ( graphInfo.graphType == GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE ||
+                     graphInfo.graphType == GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE );
+
+    double checked = now();
+    EulerianCycleResult cycleResult = { false, NULL };
+    EulerianCircuit circuit = { false, NULL, 0 };
+    if( proceed && engine->engine == ENGINE_LIST_MERGING )
+        cycleResult = findEulerianCycle( graph, graphInfo, engine->listBackend );
+    else if( proceed && engine->engine == ENGINE_ITERATIVE )
+        circuit = findEulerianCircuit( graph, graphInfo );
+    else if( proceed && engine->engine == ENGINE_NON_DESTRUCTIVE )
+        circuit = findEulerianCircuitNonDestructive( graph, graphInfo );
+    else if( proceed )
+        circuit = findEulerianCircuitParallel( graph, graphInfo, threadCount );
+
+    double solved = now();
+    OutputWriter *output = outputWriter_open( "/dev/null" );
+    assert( output != NULL );
+
+    if( cycleResult.exists )
+    {
+        PathIterator pathIterator;
+        for( pathIterator_toFirst( &pathIterator, cycleResult.eulerianCycle );
+             !pathIterator_isAtEnd( &pathIterator, cycleResult.eulerianCycle );
+             pathIterator_increment( &pathIterator, cycleResult.eulerianCycle ))
+        {
+            outputWriter_writeInt( output, pathIterator_get( &pathIterator, cycleResult.eulerianCycle )->vertexNum );
+            outputWriter_writeChar( output, ' ' );
+        }
+    }
+    else if( circuit.exists )
+    {
+        size_t position;
+        for( position = 0; position < circuit.length; position++ )
+        {
+            outputWriter_writeInt( output, circuit.vertices[ position ] );
+            outputWriter_writeChar( output, ' ' );
+        }
+    }
+    else
+    {
+        outputWriter_writeString( output, "-1" );
+    }
+
+    outputWriter_writeChar( output, '\n' );
+    outputWriter_destroy( output );
+    double printed = now();
+
+    // In an arena, the graph and the path go away at once.
+    bool found = cycleResult.exists || circuit.exists;
+    free( circuit.vertices );
+    if( arena != NULL )
+    {
+        arenaAllocator_destroy( arena );
+    }
+    else
+    {
+        if( cycleResult.eulerianCycle != NULL )
+            path_destroyAll( cycleResult.eulerianCycle );
+        graph_destroyAll( graph );
+    }
+    double tornDown = now();
+
+    times->parse = parsed - start;
+    times->build = built - parsed;
+    times->check = checked - built;
+    times->solve = solved - checked;
+    times->print = printed - solved;
+    times->teardown = tornDown - printed;
+
+    return found;
+}
+
+
+/**
+ * @brief Runs one engine on one graph in a child process and prints its JSON line.
+ * The child inherits the generated text, so it doesn't count towards the time but towards the peak memory
+ * like a mapped file would.
+ * @return false, if the child failed or found the wrong result.
+ */
+static bool benchmark( const Family *family, GraphText *graphText, const BenchEngine *engine, int threadCount, EulerianMemory memory )
+{
+    fflush( stdout );
+
+    pid_t child = fork();
+    assert( child >= 0 );
+
+    if( child == 0 )
+    {
+        PhaseTimes times;
+        bool found = runPhases( graphText, engine, threadCount, memory, &times );
+        double total = times.parse + times.build + times.check + times.solve + times.print + times.teardown;
+
+        struct rusage usage;
+        getrusage( RUSAGE_SELF, &usage );
+
+        printf( "{\"family\":\"%s\",\"engine\":\"%s\",\"threads\":%d,\"memory\":\"%s\",\"vertices\":%d,\"edges\":%zu,\"found\":%s,"
+                "\"parse_s\":%.6f,\"build_s\":%.6f,\"check_s\":%.6f,\"solve_s\":%.6f,\"print_s\":%.6f,\"teardown_s\":%.6f,"
+                "\"total_s\":%.6f,\"edges_per_s\":%.0f,\"peak_rss_kb\":%ld}\n",
+                family->name, engine->name, engine->engine == ENGINE_PARALLEL ? threadCount : 1, memoryNames[ memory ],
+                graphText->vertexCount, graphText->edgeCount, found ? "true" : "false",
+                times.parse, times.build, times.check, times.solve, times.print, times.teardown, total,
+                total > 0 ? (double) graphText->edgeCount / total : 0.0, usage.ru_maxrss );
+        fflush( stdout );
+
+        _exit( found == family->hasPath ? 0 : 1 );
+    }
+
+    int status;
+    waitpid( child, &status, 0 );
+    if( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 )
+        return true;
+
+    fprintf( stderr, "%s/%s: %s\n", family->name, engine->name,
+             WIFSIGNALED( status ) ? "abgebrochen" : "falsches Ergebnis" );
+    return false;
+}
+
+
+int main( int argc, char *argv[] )
+{
+    size_t edgeCount = BENCH_DEFAULT_EDGE_COUNT;
+    long processorCount = sysconf( _SC_NPROCESSORS_ONLN );
+    int threadCount = processorCount > 0 ? (int) processorCount : 1;
+    const char *familyName = NULL;
+    const char *engineName = NULL;
+    EulerianMemory memory = EULERIAN_MEMORY_HEAP;
+
+    // Parse the options:
+    // '-s <count>' generates graphs with about this many edge pairs.
+    // '-t <count>' runs the parallel engine with this many threads. The default is the number of processors.
+    // '-f <family>' only runs this graph family.
+    // '-e <engine>' only runs this engine.
+    // '-a' keeps the graphs and paths in an arena, '-A' in an arena which is backed by huge pages.
+    int option;
+    while(( option = getopt( argc, argv, "aAs:t:f:e:" )) != -1 )
+    {
+        switch( option )
+        {
+        case 'a':
+            memory = EULERIAN_MEMORY_ARENA;
+            break;
+        case 'A':
+            memory = EULERIAN_MEMORY_HUGE_PAGES;
+            break;
+        case 's':
+            edgeCount = (size_t) atol( optarg );
+            break;
+        case 't':
+            threadCount = atoi( optarg );
+            break;
+        case 'f':
+            familyName = optarg;
+            break;
+        case 'e':
+            engineName = optarg;
+            break;
+        default:
+            fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+            return 1;
+        }
+    }
+
+    if( edgeCount < 16 || edgeCount > INT32_MAX / 4 || threadCount < 1 )
+    {
+        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+        return 1;
+    }
+
+    bool allCorrect = true;
+    size_t familyNum;
+    for( familyNum = 0; familyNum < sizeof( families ) / sizeof( families[ 0 ] ); familyNum++ )
+    {
+        const Family *family = &families[ familyNum ];
+        if( familyName != NULL && strcmp( familyName, family->name ) != 0 )
+            continue;
+
+        GraphText graphText;
+        family->generate( &graphText, edgeCount );
+
+        size_t engineNum;
+        for( engineNum = 0; engineNum < sizeof( engines ) / sizeof( engines[ 0 ] ); engineNum++ )
+        {
+            const BenchEngine *engine = &engines[ engineNum ];
+            if( engineName != NULL && strcmp( engineName, engine->name ) != 0 )
+                continue;
+
+            if( !benchmark( family, &graphText, engine, threadCount, memory ))
+                allCorrect = false;
+        }
+
+        free( graphText.text );
+    }
+
+    return allCorrect ? 0 : 1;
+}
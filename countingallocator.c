@@ -0,0 +1,102 @@
+#include "countingallocator.h"
+
+
+/**
+ * @brief Adds bytes to the live bytes and updates the peak.
+ */
+static void addLiveBytes( CountingAllocator *counter, size_t size )
+{
+    counter->liveBytes += size;
+    if( counter->liveBytes > counter->peakBytes )
+        counter->peakBytes = counter->liveBytes;
+    return;
+}
+
+
+static void *countingAllocate( void *context, size_t size )
+{
+    CountingAllocator *counter = (CountingAllocator *) context;
+
+    void *pointer = counter->parent->allocate( counter->parent->context, size );
+    if( pointer != NULL )
+    {
+        counter->allocationCount++;
+        addLiveBytes( counter, size );
+    }
+
+    return pointer;
+}
+
+
+static void *countingReallocate( void *context, void *pointer, size_t oldSize, size_t newSize )
+{
+    CountingAllocator *counter = (CountingAllocator *) context;
+
+    // Let the helper fall back to allocate and copy if the parent can't resize.
+    void *resized = allocator_reallocate( counter->parent, pointer, oldSize, newSize );
+    if( resized != NULL )
+    {
+        counter->reallocationCount++;
+        counter->liveBytes -= oldSize;
+        addLiveBytes( counter, newSize );
+    }
+
+    return resized;
+}
+
+
+static void countingRelease( void *context, void *pointer, size_t size )
+{
+    CountingAllocator *counter = (CountingAllocator *) context;
+
+    allocator_release( counter->parent, pointer, size );
+    counter->releaseCount++;
+    counter->liveBytes -= size;
+    return;
+}
+
+
+CountingAllocator *countingAllocator_new( const Allocator *parent )
+{
+    CountingAllocator *counter = (CountingAllocator *) malloc( sizeof( CountingAllocator ));
+    assert( counter != NULL );
+
+    counter->allocator.allocate = countingAllocate;
+    counter->allocator.reallocate = countingReallocate;
+    counter->allocator.release = countingRelease;
+    counter->allocator.context = counter;
+
+    counter->parent = parent != NULL ? parent : allocator_getDefault();
+    counter->allocationCount = 0;
+    counter->reallocationCount = 0;
+    counter->releaseCount = 0;
+    counter->liveBytes = 0;
+    counter->peakBytes = 0;
+
+    return counter;
+}
+
+
+void countingAllocator_destroy( CountingAllocator *counter )
+{
+    free( counter );
+    return;
+}
+
+
+const Allocator *countingAllocator_get( CountingAllocator *counter )
+{
+    return &counter->allocator;
+}
+
+
+size_t countingAllocator_getLiveBytes( CountingAllocator *counter )
+{
+    return counter->liveBytes;
+}
+
+
+size_t countingAllocator_getPeakBytes( CountingAllocator *counter )
+{
+    return counter->peakBytes;
+}
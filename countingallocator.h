@@ -0,0 +1,81 @@
+/**
+ * @file countingallocator.h
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief An allocator which counts the memory another allocator hands out.
+ */
+
+
+#ifndef COUNTINGALLOCATOR
+#define COUNTINGALLOCATOR
+
+
+#include "allocator.h"
+
+
+/**
+ * @brief Wraps an allocator and keeps track of the calls and the number of bytes in use.
+ *
+ * Every call is passed on to the wrapped allocator, so this can be put in front of any allocator
+ * to find out how much memory a graph or a path needs.
+ * The counters are not synchronized: an allocator which is shared by several threads must not be counted.
+ */
+typedef struct
+{
+    Allocator           allocator;          /**< The functions which count and pass the calls on. Its context is the counting allocator. */
+    const Allocator *   parent;             /**< The wrapped allocator. */
+    size_t              allocationCount;    /**< The number of allocated blocks. */
+    size_t              reallocationCount;  /**< The number of resized blocks. */
+    size_t              releaseCount;       /**< The number of released blocks. */
+    size_t              liveBytes;          /**< The number of bytes which are in use right now. */
+    size_t              peakBytes;          /**< The largest number of bytes which have been in use at once. */
+} CountingAllocator;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new counting allocator with all counters set to 0.
+ * @param parent The allocator to wrap or NULL for the default allocator.
+ * @return The pointer to the new counting allocator.
+ */
+CountingAllocator *countingAllocator_new( const Allocator *parent );
+
+
+/**
+ * @brief Frees the counting allocator. It doesn't release any blocks.
+ * @param counter
+ */
+void countingAllocator_destroy( CountingAllocator *counter );
+
+
+/**
+ * @param counter
+ * @return The allocator to pass to the constructors.
+ */
+const Allocator *countingAllocator_get( CountingAllocator *counter );
+
+
+/**
+ * @param counter
+ * @return The number of bytes which are in use right now.
+ */
+size_t countingAllocator_getLiveBytes( CountingAllocator *counter );
+
+
+/**
+ * @param counter
+ * @return The largest number of bytes which have been in use at once.
+ */
+size_t countingAllocator_getPeakBytes( CountingAllocator *counter );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // COUNTINGALLOCATOR
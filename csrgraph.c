@@ -0,0 +1,321 @@
+#include "csrgraph.h"
+#include "string.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+
+CsrGraph *csrGraph_newFromEdgePairs( int vertexCount, const int *edgePairs, int edgePairCount )
+{
+    CsrGraph *graph = (CsrGraph *) malloc( sizeof( CsrGraph ));
+    assert( graph != NULL );
+
+    graph->vertexCount = vertexCount;
+    graph->halfEdgeCount = 2 * edgePairCount;
+    graph->offsets = (int *) calloc( vertexCount + 1, sizeof( int ));
+    graph->neighbors = (int *) malloc( (size_t) graph->halfEdgeCount * sizeof( int ));
+    graph->twins = (int *) malloc( (size_t) graph->halfEdgeCount * sizeof( int ));
+    assert( graph->offsets != NULL && graph->neighbors != NULL && graph->twins != NULL );
+    graph->ownsArrays = true;
+    graph->mapping = NULL;
+    graph->mappingSize = 0;
+
+    // Count the degree of each vertex. We store it one entry ahead, so the prefix sum gives the offsets.
+    int pairNum;
+    for( pairNum = 0; pairNum < edgePairCount; pairNum++ )
+    {
+        int vertexNum1 = edgePairs[ 2 * pairNum ];
+        int vertexNum2 = edgePairs[ 2 * pairNum + 1 ];
+        assert( vertexNum1 >= 0 && vertexNum1 < vertexCount );
+        assert( vertexNum2 >= 0 && vertexNum2 < vertexCount );
+
+        graph->offsets[ vertexNum1 + 1 ]++;
+        graph->offsets[ vertexNum2 + 1 ]++;
+    }
+
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+        graph->offsets[ vertexNum + 1 ] += graph->offsets[ vertexNum ];
+
+    // Scatter the half-edges into the rows. We use a copy of the offsets as the fill position of each row.
+    int *fill = (int *) malloc( vertexCount * sizeof( int ));
+    assert( fill != NULL );
+    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+        fill[ vertexNum ] = graph->offsets[ vertexNum ];
+
+    for( pairNum = 0; pairNum < edgePairCount; pairNum++ )
+    {
+        int vertexNum1 = edgePairs[ 2 * pairNum ];
+        int vertexNum2 = edgePairs[ 2 * pairNum + 1 ];
+
+        int edgeIndex1 = fill[ vertexNum1 ]++;
+        int edgeIndex2 = fill[ vertexNum2 ]++;
+
+        graph->neighbors[ edgeIndex1 ] = vertexNum2;
+        graph->neighbors[ edgeIndex2 ] = vertexNum1;
+        graph->twins[ edgeIndex1 ] = edgeIndex2;
+        graph->twins[ edgeIndex2 ] = edgeIndex1;
+    }
+
+    free( fill );
+
+    return graph;
+}
+
+
+void csrGraph_destroy( CsrGraph *graph )
+{
+    if( graph->mapping != NULL )
+    {
+        munmap( graph->mapping, graph->mappingSize );
+    }
+    else if( graph->ownsArrays )
+    {
+        free( graph->offsets );
+        free( graph->neighbors );
+        free( graph->twins );
+    }
+
+    free( graph );
+    return;
+}
+
+
+bool csrGraph_save( CsrGraph *graph, const char *filename )
+{
+    FILE *file = fopen( filename, "wb" );
+    if( file == NULL )
+        return false;
+
+    CsrGraphFileHeader header;
+    memcpy( header.magic, CSRGRAPH_FILE_MAGIC, sizeof( header.magic ));
+    header.version = CSRGRAPH_FILE_VERSION;
+    header.byteOrderMark = 0x01020304;
+    header.vertexCount = graph->vertexCount;
+    header.halfEdgeCount = graph->halfEdgeCount;
+
+    size_t halfEdgeCount = (size_t) graph->halfEdgeCount;
+    bool written = fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+                   fwrite( graph->offsets, sizeof( int ), graph->vertexCount + 1, file ) == (size_t) graph->vertexCount + 1 &&
+                   fwrite( graph->neighbors, sizeof( int ), halfEdgeCount, file ) == halfEdgeCount &&
+                   fwrite( graph->twins, sizeof( int ), halfEdgeCount, file ) == halfEdgeCount;
+
+    // Closing flushes the buffer, which may fail as well.
+    if( fclose( file ) != 0 )
+        written = false;
+
+    return written;
+}
+
+
+/**
+ * @brief Checks that the arrays of a loaded graph describe a valid graph,
+ * so the algorithms can trust them just like the arrays of a graph built in memory.
+ */
+static bool isConsistent( CsrGraph *graph )
+{
+    if( graph->offsets[ 0 ] != 0 || graph->offsets[ graph->vertexCount ] != graph->halfEdgeCount )
+        return false;
+
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < graph->vertexCount; vertexNum++ )
+    {
+        if( graph->offsets[ vertexNum + 1 ] < graph->offsets[ vertexNum ] )
+            return false;
+    }
+
+    // Every half-edge must go to an existing vertex and its twin must lie in the row of that vertex and point back.
+    for( vertexNum = 0; vertexNum < graph->vertexCount; vertexNum++ )
+    {
+        int edgeIndex;
+        for( edgeIndex = graph->offsets[ vertexNum ]; edgeIndex < graph->offsets[ vertexNum + 1 ]; edgeIndex++ )
+        {
+            int toVertexNum = graph->neighbors[ edgeIndex ];
+            if( toVertexNum < 0 || toVertexNum >= graph->vertexCount )
+                return false;
+
+            int twin = graph->twins[ edgeIndex ];
+            if( twin < graph->offsets[ toVertexNum ] || twin >= graph->offsets[ toVertexNum + 1 ] ||
+                twin == edgeIndex || graph->twins[ twin ] != edgeIndex )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+CsrGraph *csrGraph_newFromBuffer( const void *buffer, size_t size, CsrGraphFileStatus *status )
+{
+    *status = CSRGRAPH_FILE_NOT_BINARY;
+
+    const CsrGraphFileHeader *header = (const CsrGraphFileHeader *) buffer;
+    if( size < sizeof( CsrGraphFileHeader ) || memcmp( header->magic, CSRGRAPH_FILE_MAGIC, sizeof( header->magic )) != 0 )
+        return NULL;
+
+    // From here on it is meant to be a binary file, so everything that doesn't fit is an error.
+    // The size is computed in 64 bits, so huge counts in a broken header can't overflow.
+    *status = CSRGRAPH_FILE_INVALID;
+    if( header->version != CSRGRAPH_FILE_VERSION || header->byteOrderMark != 0x01020304 ||
+        header->vertexCount < 0 || header->halfEdgeCount < 0 || header->halfEdgeCount % 2 != 0 ||
+        (uint64_t) size != sizeof( CsrGraphFileHeader ) +
+                           ((uint64_t) header->vertexCount + 1 + 2 * (uint64_t) header->halfEdgeCount ) * sizeof( int32_t ))
+        return NULL;
+
+    CsrGraph *graph = (CsrGraph *) malloc( sizeof( CsrGraph ));
+    assert( graph != NULL );
+
+    graph->vertexCount = header->vertexCount;
+    graph->halfEdgeCount = header->halfEdgeCount;
+    graph->offsets = (int *) ( header + 1 );
+    graph->neighbors = graph->offsets + graph->vertexCount + 1;
+    graph->twins = graph->neighbors + graph->halfEdgeCount;
+    graph->ownsArrays = false;
+    graph->mapping = NULL;
+    graph->mappingSize = 0;
+
+    if( !isConsistent( graph ))
+    {
+        free( graph );
+        return NULL;
+    }
+
+    *status = CSRGRAPH_FILE_OK;
+    return graph;
+}
+
+
+CsrGraph *csrGraph_load( const char *filename, CsrGraphFileStatus *status )
+{
+    *status = CSRGRAPH_FILE_UNREADABLE;
+
+    int fd = open( filename, O_RDONLY );
+    if( fd < 0 )
+        return NULL;
+
+    // Files which cannot be mapped or are too short for the header can't be binary graph files.
+    struct stat fileStat;
+    if( fstat( fd, &fileStat ) != 0 )
+    {
+        close( fd );
+        return NULL;
+    }
+
+    *status = CSRGRAPH_FILE_NOT_BINARY;
+    size_t size = (size_t) fileStat.st_size;
+    if( !S_ISREG( fileStat.st_mode ) || size < sizeof( CsrGraphFileHeader ))
+    {
+        close( fd );
+        return NULL;
+    }
+
+    // The mapping stays valid after closing the file.
+    void *mapping = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if( mapping == MAP_FAILED )
+    {
+        *status = CSRGRAPH_FILE_UNREADABLE;
+        return NULL;
+    }
+
+    CsrGraph *graph = csrGraph_newFromBuffer( mapping, size, status );
+    if( graph == NULL )
+    {
+        munmap( mapping, size );
+        return NULL;
+    }
+
+    graph->mapping = mapping;
+    graph->mappingSize = size;
+
+    return graph;
+}
+
+
+int csrGraph_getVertexCount( CsrGraph *graph )
+{
+    return graph->vertexCount;
+}
+
+
+int csrGraph_getEdgePairCount( CsrGraph *graph )
+{
+    return graph->halfEdgeCount / 2;
+}
+
+
+int csrGraph_getDegree( CsrGraph *graph, int vertexNum )
+{
+    return graph->offsets[ vertexNum + 1 ] - graph->offsets[ vertexNum ];
+}
+
+
+int csrGraph_getFirstEdge( CsrGraph *graph, int vertexNum )
+{
+    return graph->offsets[ vertexNum ];
+}
+
+
+int csrGraph_getToVertexNum( CsrGraph *graph, int edgeIndex )
+{
+    return graph->neighbors[ edgeIndex ];
+}
+
+
+int csrGraph_getCorrespondingEdge( CsrGraph *graph, int edgeIndex )
+{
+    return graph->twins[ edgeIndex ];
+}
+
+
+bool csrGraph_hasEdges( CsrGraph *graph )
+{
+    return graph->halfEdgeCount > 0;
+}
+
+
+CsrGraphBuilder *csrGraphBuilder_new( int vertexCount )
+{
+    CsrGraphBuilder *builder = (CsrGraphBuilder *) malloc( sizeof( CsrGraphBuilder ));
+    assert( builder != NULL );
+
+    builder->vertexCount = vertexCount;
+    builder->edgePairCount = 0;
+    builder->edgePairCapacity = 0;
+    builder->edgePairs = NULL;
+
+    return builder;
+}
+
+
+void csrGraphBuilder_destroy( CsrGraphBuilder *builder )
+{
+    free( builder->edgePairs );
+    free( builder );
+    return;
+}
+
+
+void csrGraphBuilder_addEdgePair( CsrGraphBuilder *builder, int vertexNum1, int vertexNum2 )
+{
+    // Double the capacity whenever the array is full, so adding edge pairs takes amortized constant time.
+    if( builder->edgePairCount == builder->edgePairCapacity )
+    {
+        builder->edgePairCapacity = builder->edgePairCapacity > 0 ? 2 * builder->edgePairCapacity : 1024;
+        builder->edgePairs = (int *) realloc( builder->edgePairs, (size_t) builder->edgePairCapacity * 2 * sizeof( int ));
+        assert( builder->edgePairs != NULL );
+    }
+
+    builder->edgePairs[ 2 * builder->edgePairCount ] = vertexNum1;
+    builder->edgePairs[ 2 * builder->edgePairCount + 1 ] = vertexNum2;
+    builder->edgePairCount++;
+
+    return;
+}
+
+
+CsrGraph *csrGraphBuilder_build( CsrGraphBuilder *builder )
+{
+    return csrGraph_newFromEdgePairs( builder->vertexCount, builder->edgePairs, builder->edgePairCount );
+}
@@ -0,0 +1,242 @@
+/**
+ * @file csrgraph.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief An immutable graph stored in compressed sparse row format.
+ */
+
+
+#ifndef CSRGRAPH
+#define CSRGRAPH
+
+
+#include "basic.h"
+#include "stdint.h"
+
+
+/**
+ * @brief The first bytes of a binary graph file.
+ */
+#define CSRGRAPH_FILE_MAGIC     "EULERCSR"
+
+
+/**
+ * @brief The version of the binary graph file format written by 'csrGraph_save()'.
+ * It must be increased whenever the layout changes.
+ */
+#define CSRGRAPH_FILE_VERSION   1
+
+
+/**
+ * @brief The header of a binary graph file.
+ *
+ * The file stores the arrays of a CsrGraph as 32-bit integers in the byte order of the machine which wrote it,
+ * right behind the header: vertexCount + 1 offsets, halfEdgeCount neighbors and halfEdgeCount twins.
+ * So a loaded file can be used in place without parsing or copying anything.
+ */
+typedef struct
+{
+    char        magic[ 8 ];         /**< CSRGRAPH_FILE_MAGIC without the terminating zero. */
+    uint32_t    version;            /**< CSRGRAPH_FILE_VERSION */
+    uint32_t    byteOrderMark;      /**< 0x01020304 in the byte order of the writer. */
+    int32_t     vertexCount;        /**< The number of vertices. */
+    int32_t     halfEdgeCount;      /**< The number of half-edges, which is twice the number of edge pairs. */
+} CsrGraphFileHeader;
+
+
+/**
+ * @brief The result of loading a binary graph file.
+ */
+typedef enum
+{
+    CSRGRAPH_FILE_OK,               /**< The graph was loaded. */
+    CSRGRAPH_FILE_NOT_BINARY,       /**< The file doesn't start with the magic bytes, so it may be a text file. */
+    CSRGRAPH_FILE_INVALID,          /**< The file has the magic bytes but an unknown version or inconsistent arrays. */
+    CSRGRAPH_FILE_UNREADABLE        /**< The file couldn't be opened or mapped. */
+} CsrGraphFileStatus;
+
+
+/**
+ * @brief An immutable bidirectional graph in compressed sparse row (CSR) format.
+ *
+ * Every edge pair between two vertices is stored as two half-edges, one in the row of each vertex.
+ * The half-edges of vertex v are the indices offsets[v] to offsets[v + 1] - 1 of the
+ * neighbors and twins arrays. Within a row, the half-edges keep the order in which the edge pairs were added.
+ *
+ * Like the corresponding edge iterator of an Edge, the twin of a half-edge is the index of the half-edge
+ * going back, so both halves of an edge pair can be found without searching.
+ * Compared to the Graph, there're no per-vertex or per-edge objects at all: each half-edge costs two ints.
+ */
+typedef struct
+{
+    int     vertexCount;        /**< The number of vertices. */
+    int     halfEdgeCount;      /**< The number of half-edges, which is twice the number of edge pairs. */
+    int *   offsets;            /**< vertexCount + 1 entries: the first half-edge of each vertex and the total count at the end. */
+    int *   neighbors;          /**< The vertex number each half-edge goes to. */
+    int *   twins;              /**< The index of the half-edge going back. */
+    bool    ownsArrays;         /**< true, if the arrays were allocated for the graph and are freed with it. */
+    void *  mapping;            /**< The mapped file the arrays point into, or NULL. */
+    size_t  mappingSize;        /**< The size of the mapped file. */
+} CsrGraph;
+
+
+/**
+ * @brief Collects edge pairs to build a CsrGraph from them.
+ */
+typedef struct
+{
+    int     vertexCount;        /**< The number of vertices of the graph to build. */
+    int     edgePairCount;      /**< The number of edge pairs collected so far. */
+    int     edgePairCapacity;   /**< The number of edge pairs which fit into the array. */
+    int *   edgePairs;          /**< Two vertex numbers per edge pair. */
+} CsrGraphBuilder;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Builds a graph from an array of edge pairs.
+ * @param vertexCount
+ * @param edgePairs Two vertex numbers per edge pair: { u0, v0, u1, v1, ... }.
+ * @param edgePairCount
+ * @return The pointer to the new graph.
+ */
+CsrGraph *csrGraph_newFromEdgePairs( int vertexCount, const int *edgePairs, int edgePairCount );
+
+
+/**
+ * @brief Frees the graph and its arrays or unmaps the file it was loaded from.
+ * @param graph
+ */
+void csrGraph_destroy( CsrGraph *graph );
+
+
+/**
+ * @brief Writes the graph to a binary graph file (see CsrGraphFileHeader).
+ * @param graph
+ * @param filename
+ * @return true, if the whole file was written.
+ */
+bool csrGraph_save( CsrGraph *graph, const char *filename );
+
+
+/**
+ * @brief Uses the contents of a binary graph file which is already in memory.
+ * The arrays of the graph point right into the buffer, which must stay valid and unchanged
+ * until the graph is destroyed. It must be aligned for ints.
+ * The checks are the same as for 'csrGraph_load()'.
+ * @param buffer
+ * @param size
+ * @param status Receives the reason if no graph is returned.
+ * @return The pointer to the graph or NULL.
+ */
+CsrGraph *csrGraph_newFromBuffer( const void *buffer, size_t size, CsrGraphFileStatus *status );
+
+
+/**
+ * @brief Maps a binary graph file into memory. The arrays of the graph point right into the mapping.
+ *
+ * Only the header is checked for files which don't start with the magic bytes,
+ * so text files can be handed on to the edge list parser.
+ * The arrays of binary files are checked for consistency, which is a single pass without any allocation.
+ * @param filename
+ * @param status Receives the reason if no graph is returned.
+ * @return The pointer to the loaded graph or NULL.
+ */
+CsrGraph *csrGraph_load( const char *filename, CsrGraphFileStatus *status );
+
+
+/**
+ * @param graph
+ * @return The number of vertices in the graph.
+ */
+int csrGraph_getVertexCount( CsrGraph *graph );
+
+
+/**
+ * @param graph
+ * @return The number of edge pairs in the graph.
+ */
+int csrGraph_getEdgePairCount( CsrGraph *graph );
+
+
+/**
+ * @param graph
+ * @param vertexNum
+ * @return The number of edges which go out of the vertex.
+ */
+int csrGraph_getDegree( CsrGraph *graph, int vertexNum );
+
+
+/**
+ * @param graph
+ * @param vertexNum
+ * @return The index of the first half-edge of the vertex.
+ */
+int csrGraph_getFirstEdge( CsrGraph *graph, int vertexNum );
+
+
+/**
+ * @param graph
+ * @param edgeIndex
+ * @return The vertex number the half-edge goes to.
+ */
+int csrGraph_getToVertexNum( CsrGraph *graph, int edgeIndex );
+
+
+/**
+ * @param graph
+ * @param edgeIndex
+ * @return The index of the half-edge going back.
+ */
+int csrGraph_getCorrespondingEdge( CsrGraph *graph, int edgeIndex );
+
+
+/**
+ * @param graph
+ * @return true, if there is at least one vertex with an edge to another vertex.
+ */
+bool csrGraph_hasEdges( CsrGraph *graph );
+
+
+/**
+ * @brief Allocates and initializes a new builder.
+ * @param vertexCount The number of vertices of the graph to build.
+ * @return The pointer to the new builder.
+ */
+CsrGraphBuilder *csrGraphBuilder_new( int vertexCount );
+
+
+/**
+ * @brief Frees the builder and the collected edge pairs.
+ * @param builder
+ */
+void csrGraphBuilder_destroy( CsrGraphBuilder *builder );
+
+
+/**
+ * @brief Collects a bidirectional edge between two vertices.
+ * @param builder
+ * @param vertexNum1
+ * @param vertexNum2
+ */
+void csrGraphBuilder_addEdgePair( CsrGraphBuilder *builder, int vertexNum1, int vertexNum2 );
+
+
+/**
+ * @brief Builds a graph from the collected edge pairs. The builder can still be used afterwards.
+ * @param builder
+ * @return The pointer to the new graph.
+ */
+CsrGraph *csrGraphBuilder_build( CsrGraphBuilder *builder );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // CSRGRAPH
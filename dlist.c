@@ -14,22 +14,40 @@ inline bool dList_isEmpty( DList *list )
 
 
 DList *dList_new( int elementSize, DestroyFunction destroyFunction )
+{
+    return dList_newWithAllocator( elementSize, destroyFunction, NULL );
+}
+
+
+/**
+ * @brief Creates a list whose nodes are taken from the pool or, if there's none, from the allocator.
+ */
+static DList *createList( int elementSize, DestroyFunction destroyFunction, DListNodePool *nodePool, const Allocator *allocator )
 {
     DListNode *begin;
     DListNode *end;
 
+    // A list always uses the same allocator as its pool.
+    if( nodePool != NULL )
+        allocator = nodePool->allocator;
+    else if( allocator == NULL )
+        allocator = allocator_getDefault();
+
     // Create the list.
-    DList *list = (DList *) malloc( sizeof( DList ));
-    assert( list != NULL );
+    DList *list = (DList *) allocator_allocate( allocator, sizeof( DList ));
 
     // Initialize the list.
     list->dataSize = elementSize;
     list->listSize = 0;
     list->destroyFunction = destroyFunction;
+    list->nodePool = nodePool;
+    list->ownsNodePool = false;
+    list->storesDataInline = false;
+    list->allocator = allocator;
 
     // We create a default begin and end node whose data is NULL.
-    begin = dListNode_new( NULL, NULL, NULL );
-    end = dListNode_new( NULL, begin, NULL );
+    begin = dListNode_new( nodePool, allocator, NULL, NULL, NULL );
+    end = dListNode_new( nodePool, allocator, NULL, begin, NULL );
     begin->next = end;
 
     // Add them to the list BUT: we do NOT count them to the list size!
@@ -40,15 +58,81 @@ DList *dList_new( int elementSize, DestroyFunction destroyFunction )
 }
 
 
+DList *dList_newWithAllocator( int elementSize, DestroyFunction destroyFunction, const Allocator *allocator )
+{
+    return createList( elementSize, destroyFunction, NULL, allocator );
+}
+
+
+DList *dList_newWithNodePool( int elementSize, DestroyFunction destroyFunction, DListNodePool *nodePool )
+{
+    return createList( elementSize, destroyFunction, nodePool, NULL );
+}
+
+
+DList *dList_newWithOwnNodePool( int elementSize, DestroyFunction destroyFunction, int nodesPerSlab, const Allocator *allocator )
+{
+    DList *list = dList_newWithNodePool( elementSize, destroyFunction, dListNodePool_new( nodesPerSlab, 0, allocator ));
+    list->ownsNodePool = true;
+
+    return list;
+}
+
+
+DList *dList_newInline( int elementSize, DListNodePool *nodePool )
+{
+    DList *list = dList_newWithNodePool( elementSize, NULL, nodePool );
+    list->storesDataInline = true;
+
+    return list;
+}
+
+
+DList *dList_newInlineWithOwnNodePool( int elementSize, int nodesPerSlab, const Allocator *allocator )
+{
+    DList *list = dList_newInline( elementSize, dListNodePool_new( nodesPerSlab, elementSize, allocator ));
+    list->ownsNodePool = true;
+
+    return list;
+}
+
+
+DListNode *dList_newNode( DList *list, Data data, DListNode *prev, DListNode *next )
+{
+    if( list->storesDataInline )
+        return dListNode_newInline( list->nodePool, list->allocator, list->dataSize, data, prev, next );
+
+    return dListNode_new( list->nodePool, list->allocator, data, prev, next );
+}
+
+
+void dList_destroyNode( DList *list, DListNode *node )
+{
+    dListNode_destroy( list->nodePool, list->allocator, node, list->storesDataInline ? list->dataSize : 0 );
+    return;
+}
+
+
 void dList_destroy( DList *list )
 {
-    free( list );
+    if( list->ownsNodePool )
+        dListNodePool_destroy( list->nodePool );
+
+    allocator_release( list->allocator, list, sizeof( DList ));
     return;
 }
 
 
 void dList_destroyAll( DList *list )
 {
+    // If there's no data to destroy and the nodes go away with the pool, we don't have to walk the list at all.
+    if( list->ownsNodePool && !list->destroyFunction )
+    {
+        dListNodePool_destroy( list->nodePool );
+        allocator_release( list->allocator, list, sizeof( DList ));
+        return;
+    }
+
     // Iteratively destroy the nodes.
     DListNode *current = list->begin->next;
     while( current != list->end )
@@ -58,24 +142,40 @@ void dList_destroyAll( DList *list )
             list->destroyFunction( current->data );
 
         current = current->next;
-        dListNode_destroy( current->prev );
+
+        // A pool of our own is released as a whole below, so we don't have to give back every single node.
+        if( !list->ownsNodePool )
+            dList_destroyNode( list, current->prev );
     }
 
-    free( list->begin );
-    free( list->end );
+    if( list->ownsNodePool )
+    {
+        dListNodePool_destroy( list->nodePool );
+    }
+    else
+    {
+        dList_destroyNode( list, list->begin );
+        dList_destroyNode( list, list->end );
+    }
 
-    free( list );
+    allocator_release( list->allocator, list, sizeof( DList ));
 
     return;
 }
 
 
+DListNodePool *dList_getNodePool( DList *list )
+{
+    return list->nodePool;
+}
+
+
 void dList_append( DList *list, Data data )
 {
     // We will insert the data between the list's end node and its previous node.
     DListNode *end = list->end;
     DListNode *endPrev = end->prev;
-    DListNode *node = dListNode_new( data, endPrev, end );
+    DListNode *node = dList_newNode( list, data, endPrev, end );
     endPrev->next = node;
     end->prev = node;
 
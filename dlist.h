@@ -11,6 +11,8 @@
 
 #include "basic.h"
 #include "dlistnode.h"
+#include "dlistnodepool.h"
+#include "allocator.h"
 
 
 /**
@@ -30,6 +32,10 @@ typedef void (*DestroyFunction)( Data );
   * Having discrete nodes for the begin and end of the list will result in fewer checks
   * compared to lists without them.
   *
+  * A list can store its data inline: Then each node carries a copy of 'dataSize' bytes right behind itself
+  * and the data pointer of the node points to that copy. Node and data are allocated at once and
+  * the data is released together with the node, so such a list has no destroy function.
+  *
   * Some defintions:
   * @code
   * An 'empty' list:
@@ -51,6 +57,10 @@ typedef struct
     DListNode *     begin;                  /**< The discrete begin node of the list. */
     DListNode *     end;                    /**< The discrete end node of the list. */
     DestroyFunction destroyFunction;        /**< A function which destroys the data of a node. */
+    DListNodePool * nodePool;               /**< The pool the nodes are taken from or NULL if every node is allocated on its own. */
+    bool            ownsNodePool;           /**< true, if the pool is destroyed together with the list. */
+    bool            storesDataInline;       /**< true, if the nodes store a copy of the data instead of a pointer to it. */
+    const Allocator *allocator;             /**< The allocator of the list and of the nodes which aren't taken from a pool. */
 } DList;
 
 
@@ -69,9 +79,86 @@ extern "C" {
 DList *dList_new( int elementSize, DestroyFunction destroyFunction );
 
 
+/**
+ * @brief Allocates and initializes a new list which takes its memory from the given allocator.
+ * @param elementSize The size of the data stored in each node.
+ * @param destroyFunction A function which destroys the data of a node.
+ * @param allocator The allocator or NULL for the default allocator.
+ * @return A pointer to the created list.
+ */
+DList *dList_newWithAllocator( int elementSize, DestroyFunction destroyFunction, const Allocator *allocator );
+
+
+/**
+ * @brief Allocates and initializes a new list whose nodes are taken from a pool.
+ * The pool is not owned by the list, so it can be shared with other lists.
+ * The list is allocated by the allocator of the pool.
+ * @param elementSize The size of the data stored in each node.
+ * @param destroyFunction A function which destroys the data of a node.
+ * @param nodePool The pool to take the nodes from. If it is NULL, this is the same as 'dList_new()'.
+ * @return A pointer to the created list.
+ */
+DList *dList_newWithNodePool( int elementSize, DestroyFunction destroyFunction, DListNodePool *nodePool );
+
+
+/**
+ * @brief Allocates and initializes a new list which creates a pool of its own.
+ * The pool is destroyed together with the list, so 'dList_destroyAll()' releases all nodes at once.
+ * @param elementSize The size of the data stored in each node.
+ * @param destroyFunction A function which destroys the data of a node.
+ * @param nodesPerSlab The number of nodes the pool allocates at once.
+ * @param allocator The allocator of the list and its pool or NULL for the default allocator.
+ * @return A pointer to the created list.
+ */
+DList *dList_newWithOwnNodePool( int elementSize, DestroyFunction destroyFunction, int nodesPerSlab, const Allocator *allocator );
+
+
+/**
+ * @brief Creates a node for the list which stores the given data (or a copy of it if the list stores its data inline).
+ * The node is not linked into the list and the size of the list is not changed.
+ * @param list
+ * @param data
+ * @param prev The previous node.
+ * @param next The next node.
+ * @return A pointer to the created node.
+ */
+DListNode *dList_newNode( DList *list, Data data, DListNode *prev, DListNode *next );
+
+
+/**
+ * @brief Gives a node of the list back to where it has been taken from. Its data is not destroyed.
+ * The node must not be linked into the list anymore and the size of the list is not changed.
+ * @param list
+ * @param node
+ */
+void dList_destroyNode( DList *list, DListNode *node );
+
+
+/**
+ * @brief Allocates and initializes a new list which stores its data inline.
+ * @param elementSize The size of the data stored in each node.
+ * @param nodePool The pool to take the nodes from or NULL to allocate every node on its own.
+ * The payload size of the pool must be the element size.
+ * @return A pointer to the created list.
+ */
+DList *dList_newInline( int elementSize, DListNodePool *nodePool );
+
+
+/**
+ * @brief Allocates and initializes a new list which stores its data inline and creates a pool of its own.
+ * @param elementSize The size of the data stored in each node.
+ * @param nodesPerSlab The number of nodes the pool allocates at once.
+ * @param allocator The allocator of the list and its pool or NULL for the default allocator.
+ * @return A pointer to the created list.
+ */
+DList *dList_newInlineWithOwnNodePool( int elementSize, int nodesPerSlab, const Allocator *allocator );
+
+
 /**
  * @brief Simply frees the pointer to the list.
  * @param list
+ *
+ * @attention If the list owns its node pool, the pool is destroyed as well!
  */
 void dList_destroy( DList *list );
 
@@ -83,6 +170,13 @@ void dList_destroy( DList *list );
 void dList_destroyAll( DList *list );
 
 
+/**
+ * @param list
+ * @return The pool the nodes of the list are taken from or NULL if they are allocated on their own.
+ */
+DListNodePool *dList_getNodePool( DList *list );
+
+
 /**
  * @param list
  * @return The number of nodes in the list excluding the discrete begin and end nodes.
@@ -101,6 +195,7 @@ bool dList_isEmpty( DList *list );
  * @brief Inserts a new node whichs stores given data after the last node of the list.
  * @param list
  * @param data The data which the new node will be storing.
+ * If the list stores its data inline, the node stores a copy of the data this points to.
  */
 void dList_append( DList *list, Data data );
 
@@ -1,4 +1,5 @@
 #include "dlistiterator.h"
+#include "instrument.h"
 
 
 DListIterator *dListIterator_getIteratorFromList( DList *list )
@@ -30,7 +31,7 @@ void dListIterator_insertAfter( DListIterator *iterator, DList *list, Data data
 {
     assert( iterator );
 
-    DListNode *newNode = dListNode_new( data, iterator, iterator->next );
+    DListNode *newNode = dList_newNode( list, data, iterator, iterator->next );
 
     // Insert the new node after the current element.
     iterator->next->prev = newNode;
@@ -54,8 +55,9 @@ void dListIterator_destroy( DListIterator *iterator, DList *list )
     iterator->next->prev = iterator->prev;
 
     // Destroy the iterator's node and its data.
-    list->destroyFunction( iterator->data );
-    dListNode_destroy( iterator );
+    if( list->destroyFunction )
+        list->destroyFunction( iterator->data );
+    dList_destroyNode( list, iterator );
 
     list->listSize--;
 
@@ -95,12 +97,20 @@ void dListIterator_merge( DListIterator **iteratorRef, DList *mainList, DList *m
 {
     DListIterator *iterator = *iteratorRef;
     assert( iterator );
-    assert( mainList->destroyFunction );
+    assert( mainList->destroyFunction || mainList->storesDataInline );
+    assert( mainList->storesDataInline == mergeList->storesDataInline );
+
+    // The nodes change their list, so both lists must take them from the same place.
+    assert( mainList->nodePool == mergeList->nodePool );
+    assert( mainList->allocator == mergeList->allocator );
+    assert( !mergeList->ownsNodePool );
 
     // Nothing to do if the merge list is empty.
     if( dList_isEmpty( mergeList ))
         return;
 
+    INSTRUMENT_COUNT( INSTRUMENT_MERGES );
+
     // Connect the previous node with the first real element of the merge list.
     iterator->prev->next = mergeList->begin->next;
     mergeList->begin->next->prev = iterator->prev;
@@ -111,8 +121,9 @@ void dListIterator_merge( DListIterator **iteratorRef, DList *mainList, DList *m
 
     // Destroy the current node of the main list.
     // The first node with data in the merge list should act as its replacement.
-    mainList->destroyFunction( iterator->data );
-    dListNode_destroy( iterator );
+    if( mainList->destroyFunction )
+        mainList->destroyFunction( iterator->data );
+    dList_destroyNode( mainList, iterator );
 
     // The iterator's current node is the first data-node of the merge list now.
     *iteratorRef = mergeList->begin->next;
@@ -124,8 +135,8 @@ void dListIterator_merge( DListIterator **iteratorRef, DList *mainList, DList *m
     // it is unusable, so we can destroy the parts that are not needed anymore.
     // However these destroy functions WON'T destroy the actual data because
     // that's still used by the main list.
-    dListNode_destroy( mergeList->begin );
-    dListNode_destroy( mergeList->end );
+    dList_destroyNode( mergeList, mergeList->begin );
+    dList_destroyNode( mergeList, mergeList->end );
     dList_destroy( mergeList );
 
     return;
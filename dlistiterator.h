@@ -182,6 +182,7 @@ Data dListIterator_search( DListIterator **iteratorRef, DList *list, Comparator
  *
  * @attention After doing this, it should be obvious that the merge list cannot be used anymore.
  * Because of that, the merge list is going to be destroyed after calling this function! So do not access it anymore!
+ * Both lists must take their nodes from the same pool and the merge list must not own it.
  */
 void dListIterator_merge( DListIterator **iteratorRef, DList *mainList, DList *mergeList );
 
@@ -1,10 +1,18 @@
 #include "dlistnode.h"
+#include "dlistnodepool.h"
+#include "string.h"
+#include "instrument.h"
 
 
-DListNode *dListNode_new( Data data, DListNode *prev, DListNode *next )
+DListNode *dListNode_new( DListNodePool *pool, const Allocator *allocator, Data data, DListNode *prev, DListNode *next )
 {
-    DListNode *node = (DListNode *) malloc( sizeof( DListNode ));
+    DListNode *node;
+    if( pool != NULL )
+        node = dListNodePool_alloc( pool );
+    else
+        node = (DListNode *) allocator_allocate( allocator, sizeof( DListNode ));
     assert( node != NULL );
+    INSTRUMENT_COUNT( INSTRUMENT_NODES_ALLOCATED );
 
     node->data = data;
     node->prev = prev;
@@ -14,8 +22,39 @@ DListNode *dListNode_new( Data data, DListNode *prev, DListNode *next )
 }
 
 
-void dListNode_destroy( DListNode *node )
+DListNode *dListNode_newInline( DListNodePool *pool, const Allocator *allocator, int dataSize, Data data, DListNode *prev, DListNode *next )
 {
-    free( node );
+    DListNode *node;
+    if( pool != NULL )
+    {
+        assert( pool->payloadSize == dataSize );
+        node = dListNodePool_alloc( pool );
+    }
+    else
+    {
+        node = (DListNode *) allocator_allocate( allocator, sizeof( DListNode ) + dataSize );
+    }
+    assert( node != NULL );
+    INSTRUMENT_COUNT( INSTRUMENT_NODES_ALLOCATED );
+
+    // The data lives right behind the node.
+    node->data = (Data) ( node + 1 );
+    memcpy( node->data, data, dataSize );
+
+    node->prev = prev;
+    node->next = next;
+
+    return node;
+}
+
+
+void dListNode_destroy( DListNodePool *pool, const Allocator *allocator, DListNode *node, int dataSize )
+{
+    INSTRUMENT_COUNT( INSTRUMENT_NODES_FREED );
+
+    if( pool != NULL )
+        dListNodePool_free( pool, node );
+    else
+        allocator_release( allocator, node, sizeof( DListNode ) + dataSize );
     return;
 }
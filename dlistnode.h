@@ -10,9 +10,11 @@
 
 
 #include "basic.h"
+#include "allocator.h"
 
 
 typedef struct DListNode DListNode;
+typedef struct DListNodePool DListNodePool;
 
 /**
  * @brief The atomic data structure of a generic doubly linked list. (DList)
@@ -32,19 +34,39 @@ extern "C" {
 
 /**
  * @brief Allocates and initializes a node.
+ * @param pool The pool to take the node from. If it is NULL, the node is allocated on its own.
+ * @param allocator The allocator of a node which is allocated on its own or NULL for the default allocator.
  * @param data The generic data the node stores.
  * @param prev The previous node.
  * @param next The next node.
  * @return A pointer to the created node.
  */
-DListNode *dListNode_new( Data data, DListNode *prev, DListNode *next );
+DListNode *dListNode_new( DListNodePool *pool, const Allocator *allocator, Data data, DListNode *prev, DListNode *next );
+
+
+/**
+ * @brief Allocates and initializes a node which stores a copy of the data right behind itself.
+ * The data pointer of the node points to that copy.
+ * @param pool The pool to take the node from. If it is NULL, the node is allocated on its own.
+ * Otherwise the payload size of the pool must be the data size.
+ * @param allocator The allocator of a node which is allocated on its own or NULL for the default allocator.
+ * @param dataSize The number of bytes to copy.
+ * @param data The data to copy.
+ * @param prev The previous node.
+ * @param next The next node.
+ * @return A pointer to the created node.
+ */
+DListNode *dListNode_newInline( DListNodePool *pool, const Allocator *allocator, int dataSize, Data data, DListNode *prev, DListNode *next );
 
 
 /**
  * @brief Frees the memory of the node.
+ * @param pool The pool the node has been taken from or NULL if it has been allocated on its own.
+ * @param allocator The allocator of a node which has been allocated on its own or NULL for the default allocator.
  * @param node The node to be destroyed.
+ * @param dataSize The number of bytes of data behind the node (0 if it doesn't store its data inline).
  */
-void dListNode_destroy( DListNode *node );
+void dListNode_destroy( DListNodePool *pool, const Allocator *allocator, DListNode *node, int dataSize );
 
 
 #ifdef __cplusplus
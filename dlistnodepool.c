@@ -0,0 +1,89 @@
+#include "dlistnodepool.h"
+
+
+/**
+ * @return The number of bytes of a slab of the pool.
+ */
+static size_t slabSize( DListNodePool *pool )
+{
+    return sizeof( DListNodeSlab ) + (size_t) pool->nodesPerSlab * pool->nodeSize;
+}
+
+
+DListNodePool *dListNodePool_new( int nodesPerSlab, int payloadSize, const Allocator *allocator )
+{
+    assert( nodesPerSlab > 0 );
+    assert( payloadSize >= 0 );
+
+    if( allocator == NULL )
+        allocator = allocator_getDefault();
+
+    DListNodePool *pool = (DListNodePool *) allocator_allocate( allocator, sizeof( DListNodePool ));
+
+    pool->nodesPerSlab = nodesPerSlab;
+    pool->payloadSize = payloadSize;
+
+    // Round up so that every node (and the payload behind it) stays aligned like a pointer.
+    pool->nodeSize = sizeof( DListNode ) + payloadSize;
+    pool->nodeSize = ( pool->nodeSize + sizeof( Data ) - 1 ) / sizeof( Data ) * sizeof( Data );
+
+    pool->slabs = NULL;
+    pool->freeNodes = NULL;
+    pool->unusedCount = 0;
+    pool->allocator = allocator;
+
+    return pool;
+}
+
+
+void dListNodePool_destroy( DListNodePool *pool )
+{
+    // The nodes live inside the slabs, so freeing the slabs releases every node at once.
+    DListNodeSlab *slab = pool->slabs;
+    while( slab != NULL )
+    {
+        DListNodeSlab *next = slab->next;
+        allocator_release( pool->allocator, slab, slabSize( pool ));
+        slab = next;
+    }
+
+    allocator_release( pool->allocator, pool, sizeof( DListNodePool ));
+    return;
+}
+
+
+DListNode *dListNodePool_alloc( DListNodePool *pool )
+{
+    // Prefer reusing a released node.
+    if( pool->freeNodes != NULL )
+    {
+        DListNode *node = pool->freeNodes;
+        pool->freeNodes = node->next;
+        return node;
+    }
+
+    // The current slab is used up, so we need a new one.
+    if( pool->unusedCount == 0 )
+    {
+        DListNodeSlab *slab = (DListNodeSlab *) allocator_allocate( pool->allocator, slabSize( pool ));
+
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->unusedCount = pool->nodesPerSlab;
+    }
+
+    // Hand out the nodes of the slab in ascending order.
+    char *nodes = (char *) pool->slabs->nodes;
+    DListNode *node = (DListNode *) ( nodes + (size_t) ( pool->nodesPerSlab - pool->unusedCount ) * pool->nodeSize );
+    pool->unusedCount--;
+
+    return node;
+}
+
+
+void dListNodePool_free( DListNodePool *pool, DListNode *node )
+{
+    node->next = pool->freeNodes;
+    pool->freeNodes = node;
+    return;
+}
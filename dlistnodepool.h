@@ -0,0 +1,99 @@
+/**
+ * @file dlistnodepool.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A pool which hands out the nodes of doubly linked lists from fixed-size slabs.
+ */
+
+#ifndef DLISTNODEPOOL
+#define DLISTNODEPOOL
+
+
+#include "basic.h"
+#include "dlistnode.h"
+#include "allocator.h"
+
+
+typedef struct DListNodeSlab DListNodeSlab;
+
+/**
+ * @brief A contiguous block of nodes. The slabs of a pool are chained so they can be released in one go.
+ */
+struct DListNodeSlab
+{
+    DListNodeSlab * next;       /**< The slab which has been allocated before this one. */
+    Data            nodes[];    /**< The nodes of the slab (including their inline data) as raw memory. */
+};
+
+
+/**
+ * @brief A pool of list nodes.
+ *
+ * Instead of calling malloc and free for every single node, the pool allocates slabs
+ * of many nodes at once and keeps released nodes in a free list for reuse.
+ * Nodes which are allocated one after another sit close together in memory.
+ *
+ * A pool can be shared by many lists (e.g. all edge lists of a graph),
+ * as long as it outlives all of them.
+ *
+ * Every node of a pool has room for a payload of a fixed size right behind it,
+ * so lists which store their data inline get node and data from one allocation.
+ */
+struct DListNodePool
+{
+    int             nodesPerSlab;   /**< The number of nodes in each slab. */
+    int             payloadSize;    /**< The number of bytes of inline data behind each node. */
+    int             nodeSize;       /**< The distance between two nodes in a slab. */
+    DListNodeSlab * slabs;          /**< The most recently allocated slab. */
+    DListNode *     freeNodes;      /**< The released nodes, chained through their next pointer. */
+    int             unusedCount;    /**< The number of never used nodes at the end of the most recent slab. */
+    const Allocator *allocator;     /**< The allocator the pool and its slabs are taken from. */
+};
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new pool. No slab is allocated until the first node is requested.
+ * @param nodesPerSlab The number of nodes allocated at once.
+ * @param payloadSize The number of bytes of inline data behind each node. Use 0 for lists which don't store their data inline.
+ * @param allocator The allocator to take the pool and its slabs from or NULL for the default allocator.
+ * @return The pointer to the new pool.
+ */
+DListNodePool *dListNodePool_new( int nodesPerSlab, int payloadSize, const Allocator *allocator );
+
+
+/**
+ * @brief Frees all slabs of the pool and the pool itself.
+ * @param pool
+ *
+ * @attention Every node which has been handed out by the pool is invalid afterwards!
+ */
+void dListNodePool_destroy( DListNodePool *pool );
+
+
+/**
+ * @brief Hands out an uninitialized node.
+ * @param pool
+ * @return The pointer to the node.
+ */
+DListNode *dListNodePool_alloc( DListNodePool *pool );
+
+
+/**
+ * @brief Gives a node back to the pool so it can be handed out again.
+ * @param pool
+ * @param node
+ */
+void dListNodePool_free( DListNodePool *pool, DListNode *node );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // DLISTNODEPOOL
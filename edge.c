@@ -6,7 +6,8 @@ Edge *edge_new( int toVertexNum )
     Edge *edge = (Edge *) malloc( sizeof( Edge ));
 
     edge->toVertexNum = toVertexNum;
-    edge->correspondingEdgeIterator = NULL;
+    edge->correspondingEdgeIndex = -1;
+    edge->handle = -1;
 
     return edge;
 }
@@ -26,16 +27,22 @@ int edge_getToVertexNum( Edge *edge )
 }
 
 
-void edge_setCorrespondingEdgeIterator( Edge *edge, DListIterator *correspondingEdgeIterator )
+void edge_setCorrespondingEdgeIndex( Edge *edge, int correspondingEdgeIndex )
 {
-    edge->correspondingEdgeIterator = correspondingEdgeIterator;
+    edge->correspondingEdgeIndex = correspondingEdgeIndex;
     return;
 }
 
 
-DListIterator *edge_getCorrespondingEdgeIterator( Edge *edge )
+int edge_getCorrespondingEdgeIndex( Edge *edge )
 {
-    return edge->correspondingEdgeIterator;
+    return edge->correspondingEdgeIndex;
+}
+
+
+EdgeHandle edge_getHandle( Edge *edge )
+{
+    return edge->handle;
 }
 
 
@@ -11,22 +11,29 @@
 
 
 #include "basic.h"
-#include "dlistiterator.h"
+
+
+/**
+ * @brief Identifies an edge pair of a graph for as long as the pair exists.
+ * Unlike the index of an edge, it doesn't change when other edges are removed.
+ */
+typedef int EdgeHandle;
 
 
 /**
  * @brief The edge between vertices in a graph.
  * Next to the vertex number of the vertex which it goes to,
- * it also stores an iterator to find its corresponding edge,
+ * it also stores the index of its corresponding edge in the edge array of that vertex,
  * meaning the edge in a bidirectional graph.
  * This is important because when we remove this edge, we must also remove
  * the corresponding edge and we want that to happen fast! Using this approach, we don't have to search it
- * incrementally in a doubly linked list but rather destroy it immediately.
+ * but rather remove it immediately.
  */
 typedef struct
 {
-    int             toVertexNum;                    /**< The vertex number of the vertex this edge goes to. */
-    DListIterator * correspondingEdgeIterator;      /**< In a bidirectional graph to have quick acces to the edge going from the 'to'-vertex to the vertex which this edge is connected with. */
+    int toVertexNum;                /**< The vertex number of the vertex this edge goes to. */
+    int correspondingEdgeIndex;     /**< In a bidirectional graph to have quick acces to the edge going from the 'to'-vertex to the vertex which this edge is connected with. */
+    EdgeHandle handle;              /**< The handle of the edge pair this edge belongs to. */
 } Edge;
 
 
@@ -58,18 +65,25 @@ int edge_getToVertexNum( Edge *edge );
 
 
 /**
- * @brief Sets the iterator to the corresponding edge.
+ * @brief Sets the index of the corresponding edge in the edge array of the 'to'-vertex.
+ * @param edge
+ * @param correspondingEdgeIndex
+ */
+void edge_setCorrespondingEdgeIndex( Edge *edge, int correspondingEdgeIndex );
+
+
+/**
  * @param edge
- * @param correspondingEdgeIterator
+ * @return Gets the index of the corresponding edge in the edge array of the 'to'-vertex.
  */
-void edge_setCorrespondingEdgeIterator( Edge *edge, DListIterator *correspondingEdgeIterator );
+int edge_getCorrespondingEdgeIndex( Edge *edge );
 
 
 /**
  * @param edge
- * @return Gets the iterator to teh corresponding edge.
+ * @return The handle of the edge pair this edge belongs to.
  */
-DListIterator *edge_getCorrespondingEdgeIterator( Edge *edge );
+EdgeHandle edge_getHandle( Edge *edge );
 
 
 /**
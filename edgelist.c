@@ -0,0 +1,376 @@
+#include "edgelist.h"
+#include "limits.h"
+#include "string.h"
+#include "pthread.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+
+/**
+ * @brief The state of the hand-written scanner. It only ever moves forward.
+ */
+typedef struct
+{
+    const char *    cursor;         /**< The next character to look at. */
+    const char *    end;            /**< One past the last character. */
+    const char *    lineStart;      /**< The first character of the current line. */
+    int             line;           /**< The current line, starting at 1. */
+} Scanner;
+
+
+static void scanner_init( Scanner *scanner, const char *buffer, size_t size )
+{
+    scanner->cursor = buffer;
+    scanner->end = buffer + size;
+    scanner->lineStart = buffer;
+    scanner->line = 1;
+    return;
+}
+
+
+static bool scanner_fail( Scanner *scanner, const char *at, const char *message, EdgeListError *error )
+{
+    error->line = scanner->line;
+    error->column = (int) ( at - scanner->lineStart ) + 1;
+    error->message = message;
+    return false;
+}
+
+
+/**
+ * @brief Skips spaces, tabs and carriage returns but stays on the current line.
+ */
+static void scanner_skipBlanks( Scanner *scanner )
+{
+    while( scanner->cursor < scanner->end &&
+           ( *scanner->cursor == ' ' || *scanner->cursor == '\t' || *scanner->cursor == '\r' ))
+        scanner->cursor++;
+    return;
+}
+
+
+/**
+ * @brief Skips blanks and line breaks, so the scanner ends up at the next number (or the end).
+ */
+static void scanner_skipEmptyLines( Scanner *scanner )
+{
+    while( true )
+    {
+        scanner_skipBlanks( scanner );
+        if( scanner->cursor == scanner->end || *scanner->cursor != '\n' )
+            return;
+
+        scanner->cursor++;
+        scanner->lineStart = scanner->cursor;
+        scanner->line++;
+    }
+}
+
+
+/**
+ * @brief Reads an unsigned decimal number which must be smaller than the limit.
+ */
+static bool scanner_readNumber( Scanner *scanner, long long limit, int *value, EdgeListError *error )
+{
+    const char *start = scanner->cursor;
+
+    if( start == scanner->end || (unsigned) ( *start - '0' ) > 9 )
+    {
+        if( start != scanner->end && *start == '-' )
+            return scanner_fail( scanner, start, "negative number", error );
+        return scanner_fail( scanner, start, "expected a number", error );
+    }
+
+    long long number = 0;
+    while( scanner->cursor < scanner->end && (unsigned) ( *scanner->cursor - '0' ) <= 9 )
+    {
+        number = number * 10 + ( *scanner->cursor - '0' );
+        if( number >= limit )
+            return scanner_fail( scanner, start, "number out of range", error );
+        scanner->cursor++;
+    }
+
+    *value = (int) number;
+    return true;
+}
+
+
+/**
+ * @brief Makes sure that nothing but blanks follows on the current line.
+ */
+static bool scanner_expectLineEnd( Scanner *scanner, EdgeListError *error )
+{
+    scanner_skipBlanks( scanner );
+    if( scanner->cursor != scanner->end && *scanner->cursor != '\n' )
+        return scanner_fail( scanner, scanner->cursor, "unexpected character", error );
+    return true;
+}
+
+
+/**
+ * @brief Appends an edge pair and doubles the capacity of the array if it is full.
+ */
+static void appendEdgePair( EdgeList *edgeList, int vertexNum1, int vertexNum2 )
+{
+    if( edgeList->edgePairCount == edgeList->edgePairCapacity )
+    {
+        edgeList->edgePairCapacity = edgeList->edgePairCapacity > 0 ? 2 * edgeList->edgePairCapacity : 1024;
+        edgeList->edgePairs = (int *) realloc( edgeList->edgePairs, edgeList->edgePairCapacity * 2 * sizeof( int ));
+        assert( edgeList->edgePairs != NULL );
+    }
+
+    edgeList->edgePairs[ 2 * edgeList->edgePairCount ] = vertexNum1;
+    edgeList->edgePairs[ 2 * edgeList->edgePairCount + 1 ] = vertexNum2;
+    edgeList->edgePairCount++;
+    return;
+}
+
+
+/**
+ * @brief Reads edge lines until the end of the scanner: exactly two vertex numbers on each line.
+ */
+static bool scanEdgePairs( Scanner *scanner, long long limit, EdgeList *edgeList, EdgeListError *error )
+{
+    while( true )
+    {
+        scanner_skipEmptyLines( scanner );
+        if( scanner->cursor == scanner->end )
+            return true;
+
+        int vertexNum1, vertexNum2;
+        if( !scanner_readNumber( scanner, limit, &vertexNum1, error ))
+            return false;
+
+        scanner_skipBlanks( scanner );
+        if( !scanner_readNumber( scanner, limit, &vertexNum2, error ) ||
+            !scanner_expectLineEnd( scanner, error ))
+            return false;
+
+        appendEdgePair( edgeList, vertexNum1, vertexNum2 );
+    }
+}
+
+
+/**
+ * @brief A part of the edge lines which is parsed by one thread.
+ * Parts start right after a line break, so every thread can count lines and columns on its own.
+ */
+typedef struct
+{
+    const char *    begin;          /**< The first character of the part. */
+    const char *    end;            /**< One past the last character of the part. */
+    long long       limit;          /**< Vertex numbers must be smaller than this. */
+    EdgeList        edgeList;       /**< Collects the edge pairs of the part. Only its array is used. */
+    int             lineCount;      /**< The number of line breaks in the part. */
+    bool            failed;         /**< true, if the part has an invalid format. */
+    EdgeListError   error;          /**< The error with the line counted from the beginning of the part. */
+} ParseTask;
+
+
+static void *parseTask_run( void *argument )
+{
+    ParseTask *task = (ParseTask *) argument;
+
+    Scanner scanner;
+    scanner_init( &scanner, task->begin, task->end - task->begin );
+
+    task->failed = !scanEdgePairs( &scanner, task->limit, &task->edgeList, &task->error );
+    task->lineCount = scanner.line - 1;
+
+    return NULL;
+}
+
+
+EdgeList *edgeList_parse( const char *buffer, size_t size, int threadCount, EdgeListError *error )
+{
+    Scanner scanner;
+    scanner_init( &scanner, buffer, size );
+
+    // We start by reading the number of vertices which must stand alone on its line.
+    // Like the edge lines, it may be preceded by blanks and empty lines.
+    scanner_skipEmptyLines( &scanner );
+
+    int vertexCount;
+    if( !scanner_readNumber( &scanner, (long long) INT_MAX + 1, &vertexCount, error ) ||
+        !scanner_expectLineEnd( &scanner, error ))
+        return NULL;
+
+    // Small inputs aren't worth starting threads for.
+    const char *bodyBegin = scanner.cursor;
+    size_t bodySize = (size_t) ( scanner.end - bodyBegin );
+    if( threadCount < 1 )
+        threadCount = 1;
+    if( (size_t) threadCount > bodySize / EDGELIST_MIN_BYTES_PER_THREAD + 1 )
+        threadCount = (int) ( bodySize / EDGELIST_MIN_BYTES_PER_THREAD ) + 1;
+
+    // Split the edge lines into parts which end right after a line break.
+    ParseTask *tasks = (ParseTask *) malloc( threadCount * sizeof( ParseTask ));
+    assert( tasks != NULL );
+
+    int taskNum;
+    const char *partBegin = bodyBegin;
+    for( taskNum = 0; taskNum < threadCount; taskNum++ )
+    {
+        const char *partEnd = scanner.end;
+        if( taskNum < threadCount - 1 )
+        {
+            partEnd = bodyBegin + bodySize / threadCount * ( taskNum + 1 );
+            if( partEnd < partBegin )
+                partEnd = partBegin;
+
+            const char *lineBreak = (const char *) memchr( partEnd, '\n', scanner.end - partEnd );
+            partEnd = ( lineBreak != NULL ) ? lineBreak + 1 : scanner.end;
+        }
+
+        ParseTask *task = &tasks[ taskNum ];
+        task->begin = partBegin;
+        task->end = partEnd;
+        task->limit = vertexCount;
+        task->edgeList.vertexCount = vertexCount;
+        task->edgeList.edgePairCount = 0;
+
+        // A typical line takes more than eight characters, so this rarely has to grow.
+        task->edgeList.edgePairCapacity = (size_t) ( partEnd - partBegin ) / 8 + 1;
+        task->edgeList.edgePairs = (int *) malloc( task->edgeList.edgePairCapacity * 2 * sizeof( int ));
+        assert( task->edgeList.edgePairs != NULL );
+
+        partBegin = partEnd;
+    }
+
+    // Every thread writes to its own task only, so they don't need to synchronize.
+    // The calling thread takes the first part itself.
+    pthread_t *threads = (pthread_t *) malloc( threadCount * sizeof( pthread_t ));
+    assert( threads != NULL );
+
+    for( taskNum = 1; taskNum < threadCount; taskNum++ )
+        pthread_create( &threads[ taskNum ], NULL, parseTask_run, &tasks[ taskNum ] );
+
+    parseTask_run( &tasks[ 0 ] );
+
+    for( taskNum = 1; taskNum < threadCount; taskNum++ )
+        pthread_join( threads[ taskNum ], NULL );
+
+    free( threads );
+
+    // Report the first error. The parts before it are complete, so their line counts tell us where it is.
+    // The first part starts on the line of the vertex count.
+    bool failed = false;
+    int firstLine = scanner.line - 1;
+    size_t edgePairCount = 0;
+    for( taskNum = 0; taskNum < threadCount; taskNum++ )
+    {
+        if( tasks[ taskNum ].failed )
+        {
+            *error = tasks[ taskNum ].error;
+            error->line += firstLine;
+            failed = true;
+            break;
+        }
+
+        firstLine += tasks[ taskNum ].lineCount;
+        edgePairCount += tasks[ taskNum ].edgeList.edgePairCount;
+    }
+
+    EdgeList *edgeList = NULL;
+    if( !failed )
+    {
+        // The array of the first part becomes the array of the result and the others are appended to it in order.
+        edgeList = (EdgeList *) malloc( sizeof( EdgeList ));
+        assert( edgeList != NULL );
+
+        *edgeList = tasks[ 0 ].edgeList;
+        tasks[ 0 ].edgeList.edgePairs = NULL;
+
+        if( edgePairCount > edgeList->edgePairCapacity )
+        {
+            edgeList->edgePairCapacity = edgePairCount;
+            edgeList->edgePairs = (int *) realloc( edgeList->edgePairs, edgePairCount * 2 * sizeof( int ));
+            assert( edgeList->edgePairs != NULL );
+        }
+
+        for( taskNum = 1; taskNum < threadCount; taskNum++ )
+        {
+            EdgeList *part = &tasks[ taskNum ].edgeList;
+            memcpy( edgeList->edgePairs + 2 * edgeList->edgePairCount, part->edgePairs, part->edgePairCount * 2 * sizeof( int ));
+            edgeList->edgePairCount += part->edgePairCount;
+        }
+    }
+
+    for( taskNum = 0; taskNum < threadCount; taskNum++ )
+        free( tasks[ taskNum ].edgeList.edgePairs );
+    free( tasks );
+
+    return edgeList;
+}
+
+
+EdgeList *edgeList_load( const char *filename, int threadCount, EdgeListError *error )
+{
+    error->line = 0;
+    error->column = 0;
+    error->message = "cannot read file";
+
+    int fd = open( filename, O_RDONLY );
+    if( fd < 0 )
+        return NULL;
+
+    struct stat fileStat;
+    if( fstat( fd, &fileStat ) != 0 )
+    {
+        close( fd );
+        return NULL;
+    }
+
+    EdgeList *edgeList = NULL;
+
+    // Regular files are mapped, so the scanner reads the page cache directly without copying.
+    if( S_ISREG( fileStat.st_mode ) && fileStat.st_size > 0 )
+    {
+        size_t size = (size_t) fileStat.st_size;
+        void *mapped = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( mapped != MAP_FAILED )
+        {
+            madvise( mapped, size, MADV_SEQUENTIAL );
+            edgeList = edgeList_parse( (const char *) mapped, size, threadCount, error );
+            munmap( mapped, size );
+            close( fd );
+            return edgeList;
+        }
+    }
+
+    // Everything else is read into memory first.
+    size_t size = 0;
+    size_t capacity = 1 << 16;
+    char *buffer = (char *) malloc( capacity );
+    assert( buffer != NULL );
+
+    ssize_t bytesRead;
+    while(( bytesRead = read( fd, buffer + size, capacity - size )) > 0 )
+    {
+        size += (size_t) bytesRead;
+        if( size == capacity )
+        {
+            capacity *= 2;
+            buffer = (char *) realloc( buffer, capacity );
+            assert( buffer != NULL );
+        }
+    }
+
+    if( bytesRead == 0 )
+        edgeList = edgeList_parse( buffer, size, threadCount, error );
+
+    free( buffer );
+    close( fd );
+
+    return edgeList;
+}
+
+
+void edgeList_destroy( EdgeList *edgeList )
+{
+    free( edgeList->edgePairs );
+    free( edgeList );
+    return;
+}
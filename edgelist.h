@@ -0,0 +1,101 @@
+/**
+ * @file edgelist.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief Parses graphs in the text format into a flat array of edge pairs.
+ */
+
+
+#ifndef EDGELIST
+#define EDGELIST
+
+
+#include "stddef.h"
+#include "basic.h"
+
+
+/**
+ * @brief Every thread which parses edge lines gets at least this many bytes.
+ */
+#define EDGELIST_MIN_BYTES_PER_THREAD   ( 1 << 20 )
+
+
+/**
+ * @brief A graph as it is written in a file: the vertex count and the edge pairs in file order.
+ *
+ * The text format is:
+ * @code
+ * <vertex count>
+ * <vertex number> <vertex number>
+ * <vertex number> <vertex number>
+ * ...
+ * @endcode
+ * Numbers are separated by spaces or tabs, lines may end with "\n" or "\r\n", and blanks at the start or end
+ * of a line as well as empty lines (also before the vertex count) are ignored.
+ * Every vertex number must be in the range [0, vertex count).
+ */
+typedef struct
+{
+    int     vertexCount;        /**< The number of vertices. */
+    int *   edgePairs;          /**< Two vertex numbers per edge pair: { u0, v0, u1, v1, ... }. */
+    size_t  edgePairCount;      /**< The number of edge pairs. */
+    size_t  edgePairCapacity;   /**< The number of edge pairs which fit into the array. */
+} EdgeList;
+
+
+/**
+ * @brief Describes why parsing failed and where.
+ */
+typedef struct
+{
+    int             line;       /**< The line of the offending character, starting at 1. 0 if the file couldn't be read at all. */
+    int             column;     /**< The column of the offending character, starting at 1. */
+    const char *    message;    /**< A short description of the problem. */
+} EdgeListError;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Maps a file into memory and parses it.
+ * Files which cannot be mapped (like pipes) are read into memory instead.
+ * @param filename
+ * @param threadCount The number of threads which parse the edge lines (see 'edgeList_parse()').
+ * @param error Receives the position and the reason if parsing fails.
+ * @return The pointer to the new edge list or NULL if the file couldn't be read or has an invalid format.
+ */
+EdgeList *edgeList_load( const char *filename, int threadCount, EdgeListError *error );
+
+
+/**
+ * @brief Parses a graph in the text format from memory. The buffer doesn't have to be terminated.
+ *
+ * The edge lines are split at line breaks into one part per thread. Each thread parses its part
+ * into a buffer of its own, and the buffers are concatenated in order afterwards,
+ * so the result is the same no matter how many threads are used.
+ * @param buffer
+ * @param size
+ * @param threadCount The number of threads to use, including the calling one.
+ * It is reduced for small inputs (see EDGELIST_MIN_BYTES_PER_THREAD).
+ * @param error Receives the position and the reason if parsing fails.
+ * @return The pointer to the new edge list or NULL if the buffer has an invalid format.
+ */
+EdgeList *edgeList_parse( const char *buffer, size_t size, int threadCount, EdgeListError *error );
+
+
+/**
+ * @brief Frees the edge list and its array.
+ * @param edgeList
+ */
+void edgeList_destroy( EdgeList *edgeList );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // EDGELIST
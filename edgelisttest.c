@@ -0,0 +1,100 @@
+/**
+ * @file edgelisttest.c
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief Checks that the text parser accepts and rejects the same inputs with one and with several threads.
+ *
+ * Every case is parsed from a buffer, so the program needs no files. It prints the failed cases and
+ * exits with 1 if there are any.
+ */
+
+
+#include "string.h"
+#include "basic.h"
+#include "edgelist.h"
+
+
+/**
+ * @brief An input and what parsing it must give.
+ */
+typedef struct
+{
+    const char *    name;           /**< What the case is about. */
+    const char *    text;           /**< The input. */
+    bool            valid;          /**< true, if the input must be accepted. */
+    int             vertexCount;    /**< The vertex count of a valid input. */
+    size_t          edgePairCount;  /**< The number of edge pairs of a valid input. */
+    int             errorLine;      /**< The line of the error of an invalid input. */
+    int             errorColumn;    /**< The column of the error of an invalid input. */
+} ParseCase;
+
+
+static const ParseCase cases[] =
+{
+    { "plain header",                   "3\n0 1\n1 2\n2 0\n",           true,  3, 3, 0, 0 },
+    { "header with leading spaces",     "  3\n0 1\n1 2\n2 0\n",         true,  3, 3, 0, 0 },
+    { "header with leading tab",        "\t3 \r\n0 1\r\n",              true,  3, 1, 0, 0 },
+    { "empty lines before header",      "\n \n3\n0 1\n",                true,  3, 1, 0, 0 },
+    { "edge lines with leading blanks", "3\n  0 1\n\t1 2\n",            true,  3, 2, 0, 0 },
+    { "header only",                    "5",                            true,  5, 0, 0, 0 },
+    { "header with a letter",           "x3\n0 1\n",                    false, 0, 0, 1, 1 },
+    { "negative header",                "  -3\n",                       false, 0, 0, 1, 3 },
+    { "two numbers in header",          " 3 4\n",                       false, 0, 0, 1, 4 },
+    { "empty input",                    "",                             false, 0, 0, 1, 1 },
+    { "vertex out of range",            " 2\n0 2\n",                    false, 0, 0, 2, 3 }
+};
+
+
+/**
+ * @brief Parses one case with the given number of threads.
+ * @return true, if the result is as expected.
+ */
+static bool checkCase( const ParseCase *parseCase, int threadCount )
+{
+    EdgeListError error = { 0, 0, NULL };
+    EdgeList *edgeList = edgeList_parse( parseCase->text, strlen( parseCase->text ), threadCount, &error );
+
+    bool passed;
+    if( parseCase->valid )
+    {
+        passed = ( edgeList != NULL && edgeList->vertexCount == parseCase->vertexCount &&
+                   edgeList->edgePairCount == parseCase->edgePairCount );
+    }
+    else
+    {
+        passed = ( edgeList == NULL && error.line == parseCase->errorLine && error.column == parseCase->errorColumn );
+    }
+
+    if( !passed )
+    {
+        fprintf( stderr, "FAIL %s (%d threads): ", parseCase->name, threadCount );
+        if( edgeList != NULL )
+            fprintf( stderr, "%d vertices, %zu edge pairs\n", edgeList->vertexCount, edgeList->edgePairCount );
+        else
+            fprintf( stderr, "line %d, column %d: %s\n", error.line, error.column, error.message );
+    }
+
+    if( edgeList != NULL )
+        edgeList_destroy( edgeList );
+
+    return passed;
+}
+
+
+int main( void )
+{
+    int failedCount = 0;
+
+    size_t caseNum;
+    for( caseNum = 0; caseNum < sizeof( cases ) / sizeof( cases[ 0 ] ); caseNum++ )
+    {
+        if( !checkCase( &cases[ caseNum ], 1 ))
+            failedCount++;
+        if( !checkCase( &cases[ caseNum ], 4 ))
+            failedCount++;
+    }
+
+    printf( "%d of %d checks failed\n", failedCount, (int) ( 2 * sizeof( cases ) / sizeof( cases[ 0 ] )));
+
+    return failedCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,282 @@
+#include "eulerian.h"
+#include "basic.h"
+#include "graph.h"
+#include "csrgraph.h"
+#include "edgelist.h"
+#include "hierholzer.h"
+#include "parallelcircuit.h"
+#include "arenaallocator.h"
+
+
+/**
+ * @brief The state of a solver. Only the library knows its layout.
+ */
+struct EulerianSolver
+{
+    int                 threadCount;    /**< The number of threads which parse text input and find the path. */
+    Graph *             graph;          /**< The loaded graph or NULL. */
+    GraphInformation    graphInfo;      /**< The degree information of the loaded graph. */
+    size_t              pathLength;     /**< The length of an eulerian path of the loaded graph. */
+    CircuitWorkspace *  workspace;      /**< The working memory which is kept between solves. */
+    ArenaAllocator *    arena;          /**< The arena the graph lives in or NULL if it is allocated piece by piece. */
+    bool                failed;         /**< true, if the last load failed. */
+    EdgeListError       error;          /**< Why the last load failed. */
+};
+
+
+EulerianSolver *eulerianSolver_new( void )
+{
+    EulerianSolver *solver = (EulerianSolver *) malloc( sizeof( EulerianSolver ));
+    assert( solver != NULL );
+
+    solver->threadCount = 1;
+    solver->graph = NULL;
+    solver->pathLength = 0;
+    solver->workspace = circuitWorkspace_new();
+    solver->arena = NULL;
+    solver->failed = false;
+
+    // Nothing is loaded yet: no edges and no error.
+    solver->graphInfo.graphType = GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE;
+    solver->graphInfo.startOrEndVertexNum1 = VERTEX_UNDEFINED;
+    solver->graphInfo.startOrEndVertexNum2 = VERTEX_UNDEFINED;
+    solver->graphInfo.vertexWithMaxDegree = VERTEX_UNDEFINED;
+    solver->error.line = 0;
+    solver->error.column = 0;
+    solver->error.message = NULL;
+
+    return solver;
+}
+
+
+/**
+ * @brief Destroys the current graph, if there is one. An arena is reset instead, which releases the graph at once.
+ */
+static void dropGraph( EulerianSolver *solver )
+{
+    if( solver->arena != NULL )
+        arenaAllocator_reset( solver->arena );
+    else if( solver->graph != NULL )
+        graph_destroyAll( solver->graph );
+
+    solver->graph = NULL;
+    solver->pathLength = 0;
+    return;
+}
+
+
+/**
+ * @return The allocator for the next graph.
+ */
+static const Allocator *getAllocator( EulerianSolver *solver )
+{
+    return solver->arena != NULL ? arenaAllocator_get( solver->arena ) : NULL;
+}
+
+
+/**
+ * @brief Makes a freshly loaded graph the graph of the solver. The degrees are only checked once per graph.
+ */
+static EulerianStatus setGraph( EulerianSolver *solver, Graph *graph )
+{
+    solver->graph = graph;
+    solver->graphInfo = checkVertexDegrees( graph, NULL );
+    solver->pathLength = ( solver->graphInfo.graphType == GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE ) ?
+                         0 : getEulerianCircuitLength( graph );
+    solver->failed = false;
+    return EULERIAN_OK;
+}
+
+
+/**
+ * @brief Remembers why loading failed.
+ */
+static EulerianStatus fail( EulerianSolver *solver, EulerianStatus status )
+{
+    solver->failed = true;
+    return status;
+}
+
+
+/**
+ * @brief Remembers why loading failed when there's no position in the input to report.
+ */
+static EulerianStatus failWithMessage( EulerianSolver *solver, EulerianStatus status, const char *message )
+{
+    solver->error.line = 0;
+    solver->error.column = 0;
+    solver->error.message = message;
+    return fail( solver, status );
+}
+
+
+/**
+ * @brief Builds the graph of the solver from a binary graph and destroys the binary graph.
+ */
+static EulerianStatus setCsrGraph( EulerianSolver *solver, CsrGraph *csrGraph )
+{
+    // Handles and degrees are ints, so a graph can't hold more edge pairs than this.
+    if( (size_t) csrGraph_getEdgePairCount( csrGraph ) > GRAPH_MAX_EDGE_PAIR_COUNT )
+    {
+        csrGraph_destroy( csrGraph );
+        return failWithMessage( solver, EULERIAN_INVALID_FORMAT, "too many edges" );
+    }
+
+    Graph *graph = graph_newFromCsrWithAllocator( csrGraph, getAllocator( solver ));
+    csrGraph_destroy( csrGraph );
+
+    return setGraph( solver, graph );
+}
+
+
+/**
+ * @brief Builds the graph of the solver from a parsed edge list and destroys the edge list.
+ */
+static EulerianStatus setEdgeList( EulerianSolver *solver, EdgeList *edgeList )
+{
+    // Handles and degrees are ints, so a graph can't hold more edge pairs than this.
+    if( edgeList->edgePairCount > GRAPH_MAX_EDGE_PAIR_COUNT )
+    {
+        edgeList_destroy( edgeList );
+        return failWithMessage( solver, EULERIAN_INVALID_FORMAT, "too many edges" );
+    }
+
+    Graph *graph = graph_newWithAllocator( edgeList->vertexCount, getAllocator( solver ));
+    graph_addEdgePairs( graph, edgeList->edgePairs, edgeList->edgePairCount );
+    edgeList_destroy( edgeList );
+
+    return setGraph( solver, graph );
+}
+
+
+void eulerianSolver_destroy( EulerianSolver *solver )
+{
+    dropGraph( solver );
+    if( solver->arena != NULL )
+        arenaAllocator_destroy( solver->arena );
+    circuitWorkspace_destroy( solver->workspace );
+    free( solver );
+    return;
+}
+
+
+void eulerianSolver_setThreadCount( EulerianSolver *solver, int threadCount )
+{
+    solver->threadCount = threadCount > 0 ? threadCount : 1;
+    return;
+}
+
+
+void eulerianSolver_setMemory( EulerianSolver *solver, EulerianMemory memory )
+{
+    dropGraph( solver );
+    if( solver->arena != NULL )
+        arenaAllocator_destroy( solver->arena );
+
+    if( memory == EULERIAN_MEMORY_HUGE_PAGES )
+        solver->arena = arenaAllocator_newWithHugePages( 0 );
+    else if( memory == EULERIAN_MEMORY_ARENA )
+        solver->arena = arenaAllocator_new( NULL, 0 );
+    else
+        solver->arena = NULL;
+    return;
+}
+
+
+EulerianStatus eulerianSolver_loadBuffer( EulerianSolver *solver, const char *buffer, size_t size )
+{
+    dropGraph( solver );
+
+    // Binary graph files are recognized by their header, just like in files.
+    CsrGraphFileStatus status;
+    CsrGraph *csrGraph = csrGraph_newFromBuffer( buffer, size, &status );
+    if( csrGraph != NULL )
+        return setCsrGraph( solver, csrGraph );
+    else if( status == CSRGRAPH_FILE_INVALID )
+    {
+        return failWithMessage( solver, EULERIAN_INVALID_FORMAT, "invalid binary graph file" );
+    }
+
+    EdgeList *edgeList = edgeList_parse( buffer, size, solver->threadCount, &solver->error );
+    if( edgeList == NULL )
+        return fail( solver, EULERIAN_INVALID_FORMAT );
+
+    return setEdgeList( solver, edgeList );
+}
+
+
+EulerianStatus eulerianSolver_loadFile( EulerianSolver *solver, const char *filename )
+{
+    dropGraph( solver );
+
+    // Binary graph files are recognized by their header. Everything else is parsed as text.
+    CsrGraphFileStatus status;
+    CsrGraph *csrGraph = csrGraph_load( filename, &status );
+    if( csrGraph != NULL )
+        return setCsrGraph( solver, csrGraph );
+    else if( status == CSRGRAPH_FILE_INVALID )
+    {
+        return failWithMessage( solver, EULERIAN_INVALID_FORMAT, "invalid binary graph file" );
+    }
+    else if( status == CSRGRAPH_FILE_UNREADABLE )
+    {
+        return failWithMessage( solver, EULERIAN_UNREADABLE_FILE, "cannot read file" );
+    }
+
+    EdgeList *edgeList = edgeList_load( filename, solver->threadCount, &solver->error );
+    if( edgeList == NULL )
+        return fail( solver, solver->error.line > 0 ? EULERIAN_INVALID_FORMAT : EULERIAN_UNREADABLE_FILE );
+
+    return setEdgeList( solver, edgeList );
+}
+
+
+const char *eulerianSolver_getError( EulerianSolver *solver, int *line, int *column )
+{
+    if( line != NULL )
+        *line = solver->failed ? solver->error.line : 0;
+    if( column != NULL )
+        *column = solver->failed ? solver->error.column : 0;
+
+    return solver->failed ? solver->error.message : NULL;
+}
+
+
+size_t eulerianSolver_getPathLength( EulerianSolver *solver )
+{
+    return solver->pathLength;
+}
+
+
+EulerianStatus eulerianSolver_solve( EulerianSolver *solver, int *vertices, size_t capacity, size_t *length )
+{
+    if( length != NULL )
+        *length = 0;
+
+    if( solver->graph == NULL )
+        return EULERIAN_NO_GRAPH;
+
+    // The degrees tell right away if there can't be a path or if there's nothing to do.
+    GraphType graphType = solver->graphInfo.graphType;
+    if( graphType == GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE )
+        return EULERIAN_OK;
+    if( graphType != GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE &&
+        graphType != GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
+        return EULERIAN_NO_PATH;
+
+    if( length != NULL )
+        *length = solver->pathLength;
+    if( capacity < solver->pathLength )
+        return EULERIAN_BUFFER_TOO_SMALL;
+
+    // The path is written right into the caller's buffer. The graph stays as it is.
+    if( !traceEulerianCircuitParallel( solver->graph, solver->graphInfo, solver->workspace,
+                                       vertices, solver->pathLength, solver->threadCount ))
+    {
+        if( length != NULL )
+            *length = 0;
+        return EULERIAN_NO_PATH;
+    }
+
+    return EULERIAN_OK;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file eulerian.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief The public interface of libeulerian: loads graphs and finds eulerian paths without spawning a process.
+ *
+ * This header only depends on the standard library, so it can be included next to anything else.
+ */
+
+
+#ifndef EULERIAN
+#define EULERIAN
+
+
+#include "stddef.h"
+
+
+/**
+ * @brief Marks the functions which are exported by the shared library.
+ */
+#if defined( __GNUC__ )
+#define EULERIAN_API    __attribute__(( visibility( "default" )))
+#else
+#define EULERIAN_API
+#endif
+
+
+/**
+ * @brief A reusable solver. It holds the loaded graph and the memory which solving needs.
+ *
+ * Loading a new graph replaces the previous one, and the working memory is kept for the next graph,
+ * so a long-running service can keep one solver per thread and avoid most allocations.
+ * A solver must not be used by two threads at the same time.
+ */
+typedef struct EulerianSolver EulerianSolver;
+
+
+/**
+ * @brief The results of the solver functions.
+ */
+typedef enum
+{
+    EULERIAN_OK = 0,                /**< Everything went fine. */
+    EULERIAN_NO_PATH,               /**< The graph has no eulerian path. */
+    EULERIAN_NO_GRAPH,              /**< No graph has been loaded yet. */
+    EULERIAN_INVALID_FORMAT,        /**< The input isn't a valid graph (see 'eulerianSolver_getError()'). */
+    EULERIAN_UNREADABLE_FILE,       /**< The file couldn't be opened or read. */
+    EULERIAN_BUFFER_TOO_SMALL       /**< The caller's buffer can't hold the path. */
+} EulerianStatus;
+
+
+/**
+ * @brief Tells where a solver keeps its graph.
+ */
+typedef enum
+{
+    EULERIAN_MEMORY_HEAP = 0,       /**< Every part of the graph is allocated on its own. This is the default. */
+    EULERIAN_MEMORY_ARENA,          /**< The graph lives in an arena which is released at once when the next graph is loaded. */
+    EULERIAN_MEMORY_HUGE_PAGES      /**< Like EULERIAN_MEMORY_ARENA, with the arena backed by huge pages where the system supports them. */
+} EulerianMemory;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new solver without a graph.
+ * @return The pointer to the new solver.
+ */
+EULERIAN_API EulerianSolver *eulerianSolver_new( void );
+
+
+/**
+ * @brief Frees the solver, its graph and its working memory.
+ * @param solver
+ */
+EULERIAN_API void eulerianSolver_destroy( EulerianSolver *solver );
+
+
+/**
+ * @brief Sets the number of threads which parse text input and find the path of large graphs. The default is 1.
+ * @param solver
+ * @param threadCount
+ */
+EULERIAN_API void eulerianSolver_setThreadCount( EulerianSolver *solver, int threadCount );
+
+
+/**
+ * @brief Sets where the solver keeps the graphs it loads. The current graph is dropped.
+ * In an arena, dropping a graph doesn't walk its vertices and edges, so replacing a large graph is much cheaper.
+ * @param solver
+ * @param memory
+ */
+EULERIAN_API void eulerianSolver_setMemory( EulerianSolver *solver, EulerianMemory memory );
+
+
+/**
+ * @brief Parses a graph in the text format from memory and makes it the graph of the solver.
+ * The first line holds the vertex count and every following line the two vertex numbers of an edge.
+ * The contents of a binary graph file are recognized as well. Then the buffer must be aligned for ints.
+ * @param solver
+ * @param buffer The text. It doesn't have to be terminated and isn't needed after the call.
+ * @param size The number of bytes in the buffer.
+ * @return EULERIAN_OK or EULERIAN_INVALID_FORMAT. On errors, the solver has no graph.
+ */
+EULERIAN_API EulerianStatus eulerianSolver_loadBuffer( EulerianSolver *solver, const char *buffer, size_t size );
+
+
+/**
+ * @brief Loads a graph from a text file or a binary graph file and makes it the graph of the solver.
+ * @param solver
+ * @param filename
+ * @return EULERIAN_OK, EULERIAN_INVALID_FORMAT or EULERIAN_UNREADABLE_FILE. On errors, the solver has no graph.
+ */
+EULERIAN_API EulerianStatus eulerianSolver_loadFile( EulerianSolver *solver, const char *filename );
+
+
+/**
+ * @brief Describes why the last load failed.
+ * @param solver
+ * @param line Receives the line of the error in text input, or 0 if there is no position. May be NULL.
+ * @param column Receives the column of the error in text input, or 0 if there is no position. May be NULL.
+ * @return The reason or NULL if the last load didn't fail.
+ */
+EULERIAN_API const char *eulerianSolver_getError( EulerianSolver *solver, int *line, int *column );
+
+
+/**
+ * @param solver
+ * @return The number of vertex numbers an eulerian path of the loaded graph consists of:
+ * the number of edges plus one, or 0 if the graph has no edges (or there's no graph).
+ * A buffer of this size is enough for 'eulerianSolver_solve()'.
+ */
+EULERIAN_API size_t eulerianSolver_getPathLength( EulerianSolver *solver );
+
+
+/**
+ * @brief Finds an eulerian cycle or path of the loaded graph and writes its vertex numbers into the caller's buffer.
+ * A cycle starts and ends at the same vertex, a path starts and ends at the two vertices with uneven degree.
+ * The graph isn't changed, so it can be solved again.
+ * @param solver
+ * @param vertices The buffer for the vertex numbers.
+ * @param capacity The number of vertex numbers which fit into the buffer.
+ * @param length Receives the number of vertex numbers of the path, even if the buffer is too small. May be NULL.
+ * It is 0 for a graph without edges.
+ * @return EULERIAN_OK, EULERIAN_NO_PATH, EULERIAN_NO_GRAPH or EULERIAN_BUFFER_TOO_SMALL.
+ */
+EULERIAN_API EulerianStatus eulerianSolver_solve( EulerianSolver *solver, int *vertices, size_t capacity, size_t *length );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // EULERIAN
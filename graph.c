@@ -1,21 +1,53 @@
 #include "graph.h"
+#include "instrument.h"
+#include "string.h"
 
 
 Graph *graph_new( int vertexCount )
 {
-    Graph *graph = (Graph *) malloc( sizeof( Graph ));
-    assert( graph != NULL );
+    return graph_newWithAllocator( vertexCount, NULL );
+}
 
-    graph->vertexCount = vertexCount;
-    graph->vertices = (Vertex **) malloc( vertexCount * sizeof( Vertex * ));
 
-    // Creating and initializing the individual vertices.
+/**
+ * @brief Sets the given range of vertices to have no edges and no edge array.
+ */
+static void clearVertices( Graph *graph, int firstVertexNum, int vertexCount )
+{
+    if( vertexCount == 0 )
+        return;
+
+    memset( graph->degrees + firstVertexNum, 0, vertexCount * sizeof( int ));
+    memset( graph->edgeCapacities + firstVertexNum, 0, vertexCount * sizeof( int ));
+
     int vertexNum;
-    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
-    {
-        Vertex *vertex = vertex_new();
-        graph->vertices[ vertexNum ] = vertex;
-    }
+    for( vertexNum = firstVertexNum; vertexNum < firstVertexNum + vertexCount; vertexNum++ )
+        graph->edges[ vertexNum ] = NULL;
+
+    return;
+}
+
+
+Graph *graph_newWithAllocator( int vertexCount, const Allocator *allocator )
+{
+    if( allocator == NULL )
+        allocator = allocator_getDefault();
+
+    Graph *graph = (Graph *) allocator_allocate( allocator, sizeof( Graph ));
+
+    graph->allocator = allocator;
+    graph->vertexCount = vertexCount;
+    graph->vertexCapacity = vertexCount;
+    graph->degrees = (int *) allocator_allocate( allocator, vertexCount * sizeof( int ));
+    graph->edges = (Edge **) allocator_allocate( allocator, vertexCount * sizeof( Edge * ));
+    graph->edgeCapacities = (int *) allocator_allocate( allocator, vertexCount * sizeof( int ));
+    graph->edgePairs = NULL;
+    graph->edgePairSlotCount = 0;
+    graph->edgePairCapacity = 0;
+    graph->freeEdgePair = -1;
+
+    // Every vertex starts without edges. An edge array is allocated when the first edge is appended.
+    clearVertices( graph, 0, vertexCount );
 
     return graph;
 }
@@ -23,29 +55,57 @@ Graph *graph_new( int vertexCount )
 
 void graph_destroy( Graph *graph )
 {
-    free( graph );
+    allocator_release( graph->allocator, graph, sizeof( Graph ));
     return;
 }
 
 
 void graph_destroyAll( Graph *graph )
 {
-    // Destroy array of vertices of the graph.
+    // Destroy the edge arrays of the vertices.
     int vertexNum;
     for( vertexNum = 0; vertexNum < graph->vertexCount; vertexNum++ )
     {
-        vertex_destroyAll( graph->vertices[ vertexNum ] );
+        allocator_release( graph->allocator, graph->edges[ vertexNum ], graph->edgeCapacities[ vertexNum ] * sizeof( Edge ));
     }
 
-    free( graph->vertices );
-    free( graph );
+    allocator_release( graph->allocator, graph->edgePairs, (size_t) graph->edgePairCapacity * sizeof( EdgePairSlot ));
+    allocator_release( graph->allocator, graph->edgeCapacities, graph->vertexCapacity * sizeof( int ));
+    allocator_release( graph->allocator, graph->edges, graph->vertexCapacity * sizeof( Edge * ));
+    allocator_release( graph->allocator, graph->degrees, graph->vertexCapacity * sizeof( int ));
+    allocator_release( graph->allocator, graph, sizeof( Graph ));
     return;
 }
 
 
-Vertex *graph_getVertex( Graph *graph, int vertexNum )
+int graph_getDegree( Graph *graph, int vertexNum )
 {
-    return graph->vertices[ vertexNum ];
+    return graph->degrees[ vertexNum ];
+}
+
+
+const int *graph_getDegrees( Graph *graph )
+{
+    return graph->degrees;
+}
+
+
+Edge *graph_getEdge( Graph *graph, int vertexNum, int edgeIndex )
+{
+    assert( edgeIndex >= 0 && edgeIndex < graph->degrees[ vertexNum ] );
+    return &graph->edges[ vertexNum ][ edgeIndex ];
+}
+
+
+Edge *graph_getEdges( Graph *graph, int vertexNum )
+{
+    return graph->edges[ vertexNum ];
+}
+
+
+const Allocator *graph_getAllocator( Graph *graph )
+{
+    return graph->allocator;
 }
 
 
@@ -55,65 +115,273 @@ int graph_getVertexCount( Graph *graph )
 }
 
 
+/**
+ * @brief Resizes the vertex arrays so they have room for the given number of vertices.
+ */
+static void setVertexCapacity( Graph *graph, int vertexCapacity )
+{
+    size_t oldCapacity = graph->vertexCapacity;
+    size_t newCapacity = vertexCapacity;
+
+    graph->degrees = (int *) allocator_reallocate( graph->allocator, graph->degrees,
+                                                   oldCapacity * sizeof( int ), newCapacity * sizeof( int ));
+    graph->edges = (Edge **) allocator_reallocate( graph->allocator, graph->edges,
+                                                   oldCapacity * sizeof( Edge * ), newCapacity * sizeof( Edge * ));
+    graph->edgeCapacities = (int *) allocator_reallocate( graph->allocator, graph->edgeCapacities,
+                                                          oldCapacity * sizeof( int ), newCapacity * sizeof( int ));
+    graph->vertexCapacity = vertexCapacity;
+    return;
+}
+
+
+/**
+ * @brief Makes sure that the edge array of a vertex can hold at least this many edges without growing.
+ */
+static void reserveEdges( Graph *graph, int vertexNum, int edgeCapacity )
+{
+    int oldCapacity = graph->edgeCapacities[ vertexNum ];
+    if( edgeCapacity <= oldCapacity )
+        return;
+
+    graph->edges[ vertexNum ] = (Edge *) allocator_reallocate( graph->allocator, graph->edges[ vertexNum ],
+                                                               oldCapacity * sizeof( Edge ), edgeCapacity * sizeof( Edge ));
+    graph->edgeCapacities[ vertexNum ] = edgeCapacity;
+    return;
+}
+
+
+/**
+ * @brief Appends an edge to the edge array of a vertex.
+ */
+static void appendEdge( Graph *graph, int vertexNum, Edge edge )
+{
+    int degree = graph->degrees[ vertexNum ];
+
+    // Double the capacity if the array is full.
+    if( degree == graph->edgeCapacities[ vertexNum ] )
+        reserveEdges( graph, vertexNum, degree > 0 ? 2 * degree : GRAPH_MIN_EDGE_CAPACITY );
+
+    graph->edges[ vertexNum ][ degree ] = edge;
+    graph->degrees[ vertexNum ] = degree + 1;
+    return;
+}
+
+
+/**
+ * @brief Resizes the array of edge pair slots so it has room for the given number of slots.
+ */
+static void setEdgePairCapacity( Graph *graph, int edgePairCapacity )
+{
+    graph->edgePairs = (EdgePairSlot *) allocator_reallocate( graph->allocator, graph->edgePairs,
+                                                              (size_t) graph->edgePairCapacity * sizeof( EdgePairSlot ),
+                                                              (size_t) edgePairCapacity * sizeof( EdgePairSlot ));
+    graph->edgePairCapacity = edgePairCapacity;
+    return;
+}
+
+
+void graph_reserve( Graph *graph, int vertexCapacity, int edgePairCapacity )
+{
+    if( vertexCapacity > graph->vertexCapacity )
+        setVertexCapacity( graph, vertexCapacity );
+
+    if( edgePairCapacity > graph->edgePairCapacity )
+        setEdgePairCapacity( graph, edgePairCapacity );
+
+    return;
+}
+
+
 void graph_addVertex( Graph *graph )
 {
-    int oldVertexCount = graph->vertexCount;
+    graph_addVertices( graph, 1 );
+    return;
+}
 
-    // Expand the vertex array with 1 vertex.
-    int newVertexCount = oldVertexCount + 1;
-    Vertex **extendedVertices = (Vertex **) malloc( newVertexCount * sizeof( Vertex * ));
-    assert( extendedVertices != NULL );
 
-    // Copy old vertices to the new vertex array.
-    int vertexNum;
-    for( vertexNum = 0; vertexNum < oldVertexCount; vertexNum++ )
+int graph_addVertices( Graph *graph, int count )
+{
+    int firstVertexNum = graph->vertexCount;
+    int newVertexCount = graph->vertexCount + count;
+
+    // Expand the vertex arrays by doubling its capacity, so we don't have to copy it every time.
+    if( newVertexCount > graph->vertexCapacity )
     {
-        extendedVertices[ vertexNum ] = graph->vertices[ vertexNum ];
+        int vertexCapacity = graph->vertexCapacity > 0 ? 2 * graph->vertexCapacity : 16;
+        if( vertexCapacity < newVertexCount )
+            vertexCapacity = newVertexCount;
+
+        setVertexCapacity( graph, vertexCapacity );
     }
 
-    // Create the new vertex and add it to the array.
-    Vertex *addedVertex = vertex_new();
-    int addedVertexNum = oldVertexCount;
-    extendedVertices[ addedVertexNum ] = addedVertex;
+    clearVertices( graph, firstVertexNum, count );
 
-    // We can now free the old array and assign the new vertices to the graph.
-    free( graph->vertices );
-    graph->vertices = extendedVertices;
     graph->vertexCount = newVertexCount;
 
+    return firstVertexNum;
+}
+
+
+/**
+ * @brief Takes a free edge pair slot or a new one if there's none.
+ */
+static EdgeHandle newEdgePairSlot( Graph *graph )
+{
+    EdgeHandle handle = graph->freeEdgePair;
+    if( handle >= 0 )
+    {
+        graph->freeEdgePair = graph->edgePairs[ handle ].edgeIndex;
+        return handle;
+    }
+
+    // Double the capacity if the array is full.
+    if( graph->edgePairSlotCount == graph->edgePairCapacity )
+        setEdgePairCapacity( graph, graph->edgePairCapacity > 0 ? 2 * graph->edgePairCapacity : 1024 );
+
+    return graph->edgePairSlotCount++;
+}
+
+
+EdgeHandle graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 )
+{
+    // Append an edge which points to vertex 2 and an edge which points to vertex 1.
+    // For a loop both go into the same array, so the second one ends up right behind the first one.
+    int edgeIndex1 = graph->degrees[ vertexNum1 ];
+    int edgeIndex2 = ( vertexNum1 == vertexNum2 ) ? edgeIndex1 + 1 : graph->degrees[ vertexNum2 ];
+
+    EdgeHandle handle = newEdgePairSlot( graph );
+    graph->edgePairs[ handle ].vertexNum = vertexNum1;
+    graph->edgePairs[ handle ].edgeIndex = edgeIndex1;
+
+    Edge edge1 = { vertexNum2, edgeIndex2, handle };
+    Edge edge2 = { vertexNum1, edgeIndex1, handle };
+    appendEdge( graph, vertexNum1, edge1 );
+    appendEdge( graph, vertexNum2, edge2 );
+
+    return handle;
+}
+
+
+void graph_addEdgePairs( Graph *graph, const int *edgePairs, size_t edgePairCount )
+{
+    assert( edgePairCount <= GRAPH_MAX_EDGE_PAIR_COUNT - (size_t) graph->edgePairSlotCount );
+
+    // Make room for all slots at once. Free slots are reused first, so this may reserve a bit more than needed.
+    graph_reserve( graph, graph->vertexCapacity, graph->edgePairSlotCount + (int) edgePairCount );
+
+    size_t pairNum;
+
+    // If the batch touches many vertices, count the added degrees first and size every edge array once.
+    // Small batches just let the arrays grow.
+    if( edgePairCount * 4 >= (size_t) graph->vertexCount )
+    {
+        int *addedDegrees = (int *) allocator_allocate( graph->allocator, graph->vertexCount * sizeof( int ));
+        memset( addedDegrees, 0, graph->vertexCount * sizeof( int ));
+
+        for( pairNum = 0; pairNum < 2 * edgePairCount; pairNum++ )
+            addedDegrees[ edgePairs[ pairNum ] ]++;
+
+        int vertexNum;
+        for( vertexNum = 0; vertexNum < graph->vertexCount; vertexNum++ )
+        {
+            if( addedDegrees[ vertexNum ] > 0 )
+                reserveEdges( graph, vertexNum, graph->degrees[ vertexNum ] + addedDegrees[ vertexNum ] );
+        }
+
+        allocator_release( graph->allocator, addedDegrees, graph->vertexCount * sizeof( int ));
+    }
+
+    for( pairNum = 0; pairNum < edgePairCount; pairNum++ )
+    {
+        graph_addEdgePair( graph, edgePairs[ 2 * pairNum ], edgePairs[ 2 * pairNum + 1 ] );
+    }
+
     return;
 }
 
 
-void graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 )
+Graph *graph_newFromCsr( CsrGraph *csrGraph )
 {
-    // Get the vertices which stores the lists of edges.
-    Vertex *vertex1 = graph->vertices[ vertexNum1 ];
-    Vertex *vertex2 = graph->vertices[ vertexNum2 ];
+    return graph_newFromCsrWithAllocator( csrGraph, NULL );
+}
 
-    // Get the lists of edges.
-    DList *edges1 = vertex_getEdges( vertex1 );
-    DList *edges2 = vertex_getEdges( vertex2 );
 
-    // Create an edge which points to vertex 2 and append it to the list.
-    Edge *edge1 = edge_new( vertexNum2 );
-    dList_append( edges1, edge1 );
+Graph *graph_newFromCsrWithAllocator( CsrGraph *csrGraph, const Allocator *allocator )
+{
+    assert( (size_t) csrGraph_getEdgePairCount( csrGraph ) <= GRAPH_MAX_EDGE_PAIR_COUNT );
 
-    // Create an iterator which stands at the appended edge.
-    DListIterator *iterator1 = dListIterator_getIteratorFromList( edges1 );
-    dListIterator_toLast( iterator1, edges1 );
+    int vertexCount = csrGraph_getVertexCount( csrGraph );
+    Graph *graph = graph_newWithAllocator( vertexCount, allocator );
+    graph_reserve( graph, vertexCount, csrGraph_getEdgePairCount( csrGraph ));
 
-    // Create an edge which points to vertex 1 and append it to the list.
-    Edge *edge2 = edge_new( vertexNum1 );
-    dList_append( edges2, edge2 );
+    // Copy the rows. The twin of a half-edge becomes an index into the row of the vertex it goes to.
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+    {
+        int firstEdge = csrGraph_getFirstEdge( csrGraph, vertexNum );
+        int degree = csrGraph_getDegree( csrGraph, vertexNum );
+        reserveEdges( graph, vertexNum, degree );
+
+        int edgeIndex;
+        for( edgeIndex = firstEdge; edgeIndex < firstEdge + degree; edgeIndex++ )
+        {
+            int toVertexNum = csrGraph_getToVertexNum( csrGraph, edgeIndex );
+            int twin = csrGraph_getCorrespondingEdge( csrGraph, edgeIndex );
+
+            Edge edge = { toVertexNum, twin - csrGraph_getFirstEdge( csrGraph, toVertexNum ), -1 };
+            appendEdge( graph, vertexNum, edge );
+        }
+    }
 
-    // Create an iterator which stays at the appended edge.
-    DListIterator *iterator2 = dListIterator_getIteratorFromList( edges2 );
-    dListIterator_toLast( iterator2, edges2 );
+    // Now that all edges exist, give every pair a slot. The half-edge with the smaller index is the first edge of its pair.
+    for( vertexNum = 0; vertexNum < vertexCount; vertexNum++ )
+    {
+        int firstEdge = csrGraph_getFirstEdge( csrGraph, vertexNum );
+
+        int edgeIndex;
+        for( edgeIndex = 0; edgeIndex < graph->degrees[ vertexNum ]; edgeIndex++ )
+        {
+            if( csrGraph_getCorrespondingEdge( csrGraph, firstEdge + edgeIndex ) < firstEdge + edgeIndex )
+                continue;
+
+            EdgeHandle handle = newEdgePairSlot( graph );
+            graph->edgePairs[ handle ].vertexNum = vertexNum;
+            graph->edgePairs[ handle ].edgeIndex = edgeIndex;
+
+            Edge *edge = graph_getEdge( graph, vertexNum, edgeIndex );
+            Edge *correspondingEdge = graph_getEdge( graph, edge_getToVertexNum( edge ), edge_getCorrespondingEdgeIndex( edge ));
+            edge->handle = handle;
+            correspondingEdge->handle = handle;
+        }
+    }
 
-    // Set up the corresponding edge with the iterators.
-    edge_setCorrespondingEdgeIterator( edge1, iterator2 );
-    edge_setCorrespondingEdgeIterator( edge2, iterator1 );
+    return graph;
+}
+
+
+/**
+ * @brief Removes a single edge and tells the corresponding edge of the edge which filled the gap about its new index.
+ * If the moved edge is the first edge of its pair, the slot of the pair is updated as well.
+ */
+static void removeEdge( Graph *graph, int vertexNum, int edgeIndex )
+{
+    assert( edgeIndex >= 0 && edgeIndex < graph->degrees[ vertexNum ] );
+
+    // Fill the gap with the last edge.
+    Edge *edges = graph->edges[ vertexNum ];
+    int movedFromIndex = --graph->degrees[ vertexNum ];
+    if( movedFromIndex == edgeIndex )
+        return;
+
+    edges[ edgeIndex ] = edges[ movedFromIndex ];
+
+    Edge *movedEdge = &edges[ edgeIndex ];
+    Edge *correspondingEdge = graph_getEdge( graph, edge_getToVertexNum( movedEdge ), edge_getCorrespondingEdgeIndex( movedEdge ));
+    edge_setCorrespondingEdgeIndex( correspondingEdge, edgeIndex );
+
+    EdgePairSlot *slot = &graph->edgePairs[ edge_getHandle( movedEdge ) ];
+    if( slot->vertexNum == vertexNum && slot->edgeIndex == movedFromIndex )
+        slot->edgeIndex = edgeIndex;
 
     return;
 }
@@ -121,52 +389,85 @@ void graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 )
 
 bool graph_removeEdgePair( Graph *graph, int vertexNum1, int vertexNum2 )
 {
-    // Get the vertices which store the lists of edges.
-    Vertex *vertex1 = graph->vertices[ vertexNum1 ];
-    Vertex *vertex2 = graph->vertices[ vertexNum2 ];
-    DList *edges1 = vertex_getEdges( vertex1 );
-    DList *edges2 = vertex_getEdges( vertex2 );
+    Edge *edges = graph->edges[ vertexNum1 ];
+
+    // Search the edge going from vertex 1 to vertex 2.
+    int edgeIndex;
+    for( edgeIndex = 0; edgeIndex < graph->degrees[ vertexNum1 ]; edgeIndex++ )
+    {
+        if( edge_getToVertexNum( &edges[ edgeIndex ] ) == vertexNum2 )
+        {
+            graph_removeEdgePairAt( graph, vertexNum1, edgeIndex );
+            return true;
+        }
+    }
+
+    // We haven't found the edge.
+    return false;
+}
+
+
+void graph_removeEdgePairAt( Graph *graph, int vertexNum, int edgeIndex )
+{
+    INSTRUMENT_COUNT( INSTRUMENT_EDGE_PAIR_REMOVALS );
 
-    if( !vertex_hasEdges( vertex1 ))
-        return false;
+    // We get the corresponding edge immediately with its index.
+    Edge *edge1 = graph_getEdge( graph, vertexNum, edgeIndex );
+    int vertexNum2 = edge_getToVertexNum( edge1 );
+    int edgeIndex2 = edge_getCorrespondingEdgeIndex( edge1 );
+    EdgeHandle handle = edge_getHandle( edge1 );
 
-    // Create an iterator which will get us the edge going from vertex 1 to vertex 2.
-    DListIterator *edgeIterator1 = dListIterator_getIteratorFromList( edges1 );
-    dListIterator_toFirst( edgeIterator1, edges1 );
+    // For a loop, both edges are in the same array. Removing the one with the higher index first
+    // makes sure that the other one is not the one which gets moved.
+    if( vertexNum == vertexNum2 && edgeIndex < edgeIndex2 )
+    {
+        int swap = edgeIndex;
+        edgeIndex = edgeIndex2;
+        edgeIndex2 = swap;
+    }
 
-    // Prepare a comparator for searching.
-    Edge searchEdge = { vertexNum2, NULL };
-    Comparator *comparator = comparator_new( &searchEdge, (CompareFunction) edge_equals );
+    // Removing an edge of vertex 1 may update corresponding indices in the array of vertex 2 but never moves its edges.
+    removeEdge( graph, vertexNum, edgeIndex );
+    removeEdge( graph, vertexNum2, edgeIndex2 );
 
-    // Search the edge.
-    Edge *edge1 = (Edge *) dListIterator_search( &edgeIterator1, edges1, comparator );
+    // The slot of the pair can be reused.
+    graph->edgePairs[ handle ].vertexNum = -1;
+    graph->edgePairs[ handle ].edgeIndex = graph->freeEdgePair;
+    graph->freeEdgePair = handle;
+
+    return;
+}
 
-    // If we haven't found the edge, we stop here.
-    if( edge1 == NULL )
-        return false;
 
-    // Now that we have edge 1, we get edge 2 immediately with the corresponding edge iterator.
-    DListIterator *edgeIterator2 = edge_getCorrespondingEdgeIterator( edge1 );
+void graph_removeEdgeByHandle( Graph *graph, EdgeHandle handle )
+{
+    assert( handle >= 0 && handle < graph->edgePairSlotCount );
 
-    // Remove the edges.
-    dListIterator_destroy( edgeIterator1, edges1 );
-    dListIterator_destroy( edgeIterator2, edges2 );
+    EdgePairSlot *slot = &graph->edgePairs[ handle ];
+    assert( slot->vertexNum >= 0 );
 
-    // Clean up.
-    comparator_destroy( comparator );
+    graph_removeEdgePairAt( graph, slot->vertexNum, slot->edgeIndex );
 
-    return true;
+    return;
 }
 
 
 bool graph_hasEdges( Graph *graph )
 {
+    // A linear sweep over the degrees, the edge arrays aren't touched.
+    const int *degrees = graph->degrees;
     int vertexNum;
     for( vertexNum = 0; vertexNum < graph->vertexCount; vertexNum++ )
     {
-        if( vertex_hasEdges( graph->vertices[ vertexNum ] ))
+        if( degrees[ vertexNum ] > 0 )
             return true;
     }
 
     return false;
 }
+
+
+int graph_getEdgeHandleBound( Graph *graph )
+{
+    return graph->edgePairSlotCount;
+}
@@ -10,18 +10,56 @@
 #define GRAPH
 
 
+#include "limits.h"
 #include "basic.h"
-#include "vertex.h"
+#include "edge.h"
+#include "csrgraph.h"
+#include "allocator.h"
 
 
 /**
- * The graph contains a onedimensional array of vertices and each vertex stores a
- * doubly linked list of edges.
+ * @brief The number of edges a vertex makes room for when it gets its first edge.
+ */
+#define GRAPH_MIN_EDGE_CAPACITY     4
+
+
+/**
+ * @brief The largest number of edge pairs a graph can hold. Handles and degrees are ints, and a vertex may hold
+ * both edges of every pair. The parallel engine counts 2 * pairs + 2 half-edges (including its virtual pair) in an int.
+ * Loaders must reject larger inputs, text and binary alike, before they build the graph.
+ */
+#define GRAPH_MAX_EDGE_PAIR_COUNT   ( (size_t) INT_MAX / 2 - 1 )
+
+
+/**
+ * @brief Tells where an edge pair is stored. The slots of removed edge pairs are chained to be reused.
+ */
+typedef struct
+{
+    int vertexNum;      /**< The vertex whose array holds the first edge of the pair or -1 if the slot is free. */
+    int edgeIndex;      /**< The index of the first edge of the pair or, if the slot is free, the next free slot. */
+} EdgePairSlot;
+
+
+/**
+ * The graph stores its vertices as parallel arrays which are indexed by the vertex number:
+ * the degree of each vertex, its contiguous array of edges and the capacity of that array.
+ * Scanning the degrees is a linear sweep over one int array, without touching the edges.
+ * An edge array grows by doubling its capacity. The order of the edges is not preserved when edges are removed.
+ * Edge pairs can be referred to by a handle: the index of a slot which always knows where the first edge of the pair is.
  */
 typedef struct
 {
-    Vertex **   vertices;           /**< A onedimensional array of pointers to vertex-objects. */
-    int         vertexCount;        /**< The number of vertices in the vertex array. */
+    int *           degrees;            /**< The number of edges of each vertex. */
+    Edge **         edges;              /**< The edge array of each vertex or NULL if it has never had an edge. */
+    int *           edgeCapacities;     /**< The number of edges which fit into the edge array of each vertex. */
+    int             vertexCount;        /**< The number of vertices. */
+    int             vertexCapacity;     /**< The number of vertices which fit into the vertex arrays. */
+    EdgePairSlot *  edgePairs;          /**< The slots of the edge pairs, indexed by their handle. */
+    int             edgePairSlotCount;  /**< The number of slots which have ever been used. */
+    int             edgePairCapacity;   /**< The number of slots which fit into the array. */
+    int             freeEdgePair;       /**< The first free slot or -1 if there's none. */
+    const Allocator *allocator;         /**< The allocator of the graph and all its arrays. */
 } Graph;
 
 
@@ -38,6 +76,35 @@ extern "C" {
 Graph *graph_new( int vertexCount );
 
 
+/**
+ * @brief Allocates and initializes a new graph which takes all its memory from the given allocator.
+ * Everything the graph creates later on (vertex arrays, edge arrays, slots) comes from the same allocator.
+ * @param vertexCount
+ * @param allocator The allocator or NULL for the default allocator. It must outlive the graph.
+ * @return The pointer to the new graph.
+ */
+Graph *graph_newWithAllocator( int vertexCount, const Allocator *allocator );
+
+
+/**
+ * @brief Creates a graph with the same edges as a CsrGraph.
+ * The edges of each vertex keep the order of its row, so the graph is the same as if the edge pairs
+ * had been added one by one. Every edge array is allocated once with its final size.
+ * @param csrGraph
+ * @return The pointer to the new graph.
+ */
+Graph *graph_newFromCsr( CsrGraph *csrGraph );
+
+
+/**
+ * @brief Creates a graph with the same edges as a CsrGraph which takes all its memory from the given allocator.
+ * @param csrGraph
+ * @param allocator The allocator or NULL for the default allocator. It must outlive the graph.
+ * @return The pointer to the new graph.
+ */
+Graph *graph_newFromCsrWithAllocator( CsrGraph *csrGraph, const Allocator *allocator );
+
+
 /**
  * @brief Simply frees the poiner to the graph.
  * @param graph
@@ -47,7 +114,7 @@ void graph_destroy( Graph *graph );
 
 /**
  * @brief Frees the pointer to the graph and completely destroys the structure
- * of the graph including all vertices and their edges.
+ * of the graph including all vertex arrays and edge arrays.
  * @param graph
  */
 void graph_destroyAll( Graph *graph );
@@ -56,9 +123,40 @@ void graph_destroyAll( Graph *graph );
 /**
  * @param graph
  * @param vertexNum
- * @return Get the vertex object at a specified vertex number.
+ * @return The number of edges which go out of the vertex.
  */
-Vertex *graph_getVertex( Graph *graph, int vertexNum );
+int graph_getDegree( Graph *graph, int vertexNum );
+
+
+/**
+ * @param graph
+ * @return The degrees of all vertices, indexed by the vertex number. It is valid until vertices are added.
+ */
+const int *graph_getDegrees( Graph *graph );
+
+
+/**
+ * @param graph
+ * @param vertexNum
+ * @param edgeIndex
+ * @return Get the edge at the given index of the edge array of the vertex.
+ */
+Edge *graph_getEdge( Graph *graph, int vertexNum, int edgeIndex );
+
+
+/**
+ * @param graph
+ * @param vertexNum
+ * @return The edge array of the vertex. It holds 'graph_getDegree()' edges and is valid until edges are added.
+ */
+Edge *graph_getEdges( Graph *graph, int vertexNum );
+
+
+/**
+ * @param graph
+ * @return The allocator the graph takes its memory from.
+ */
+const Allocator *graph_getAllocator( Graph *graph );
 
 
 /**
@@ -68,27 +166,58 @@ Vertex *graph_getVertex( Graph *graph, int vertexNum );
 int graph_getVertexCount( Graph *graph );
 
 
+/**
+ * @brief Makes room for the given number of vertices and edge pairs, so that adding them doesn't
+ * have to grow any arrays of the graph. It never shrinks anything.
+ * @param graph
+ * @param vertexCapacity The total number of vertices the graph should have room for.
+ * @param edgePairCapacity The total number of edge pairs the graph should have room for.
+ */
+void graph_reserve( Graph *graph, int vertexCapacity, int edgePairCapacity );
+
+
 /**
  * @brief This adds a vertex to the graph.
+ * The vertex arrays grow by doubling their capacity, so adding n vertices one by one takes O(n) time in total.
  * @param graph
- *
- * @attention This function can be slow on a graph with a large number of vertices since it
- * creates a new array of the current size + 1 and copies all vertices from the old array into the new one.
  */
 void graph_addVertex( Graph *graph );
 
 
+/**
+ * @brief Adds a number of vertices at once.
+ * @param graph
+ * @param count
+ * @return The vertex number of the first added vertex.
+ */
+int graph_addVertices( Graph *graph, int count );
+
+
 /**
  * @brief Adds a bidirectional edge betweenn two vertices.
  * @param graph
  * @param vertexNum1
  * @param vertexNum2
+ * @return A handle which stays valid until the edge pair is removed. It may be reused afterwards.
+ */
+EdgeHandle graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 );
+
+
+/**
+ * @brief Adds many bidirectional edges at once.
+ * Large batches are added in two passes: the degrees are counted first, so every edge array
+ * is allocated once with its final size, and then the edges are scattered into them.
+ * @param graph
+ * @param edgePairs Two vertex numbers per edge pair: { u0, v0, u1, v1, ... }.
+ * @param edgePairCount The number of edge pairs (which is half the number of ints).
+ * Together with the edge pairs of the graph, it must not exceed GRAPH_MAX_EDGE_PAIR_COUNT.
  */
-void graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 );
+void graph_addEdgePairs( Graph *graph, const int *edgePairs, size_t edgePairCount );
 
 
 /**
  * @brief Removes a bidirectional edge between two vertices.
+ * This has to search the edge array of vertex 1.
  * @param graph
  * @param vertexNum1
  * @param vertexNum2
@@ -97,6 +226,27 @@ void graph_addEdgePair( Graph *graph, int vertexNum1, int vertexNum2 );
 bool graph_removeEdgePair( Graph *graph, int vertexNum1, int vertexNum2 );
 
 
+/**
+ * @brief Removes the edge at the given index of the edge array of a vertex and its corresponding edge.
+ * This takes constant time: the gaps are filled with the last edges of the arrays.
+ * @param graph
+ * @param vertexNum
+ * @param edgeIndex
+ *
+ * @attention The indices of other edges of both vertices may change!
+ */
+void graph_removeEdgePairAt( Graph *graph, int vertexNum, int edgeIndex );
+
+
+/**
+ * @brief Removes the edge pair with the given handle.
+ * This takes constant time and doesn't allocate anything, no matter how many edges the vertices have.
+ * @param graph
+ * @param handle
+ */
+void graph_removeEdgeByHandle( Graph *graph, EdgeHandle handle );
+
+
 /**
  * @param graph
  * @return true, if there is at least one vertex with an edge to another vertex.
@@ -104,6 +254,14 @@ bool graph_removeEdgePair( Graph *graph, int vertexNum1, int vertexNum2 );
 bool graph_hasEdges( Graph *graph );
 
 
+/**
+ * @param graph
+ * @return An upper bound of the edge handles: every handle of the graph is smaller than this.
+ * It can be used to size arrays which are indexed by handles.
+ */
+int graph_getEdgeHandleBound( Graph *graph );
+
+
 #ifdef __cplusplus
 }
 #endif
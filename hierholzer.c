@@ -0,0 +1,407 @@
+#include "hierholzer.h"
+#include "pathelement.h"
+#include "pathiterator.h"
+#include "string.h"
+#include "instrument.h"
+
+
+GraphInformation checkVertexDegrees( Graph *graph, UnionFind *components )
+{
+    // We're optimistic and assume that two or less vertices with uneven degree at the beginning.
+    GraphInformation graphInfo = {
+            GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE,
+            VERTEX_UNDEFINED,
+            VERTEX_UNDEFINED,
+            VERTEX_UNDEFINED
+    };
+    int unevenDegreeCount = 0;
+    int maxDegree = 0;
+    int vertexWithMaxDegree = VERTEX_UNDEFINED;
+    int componentRoot = VERTEX_UNDEFINED;
+    bool disconnected = false;
+
+    // Loop through every vertex. The degrees lie next to each other, so this is a linear sweep.
+    const int *degrees = graph_getDegrees( graph );
+    int currVertexNum;
+    for( currVertexNum = 0; currVertexNum < graph_getVertexCount( graph ); currVertexNum++ )
+    {
+        int degree = degrees[ currVertexNum ];
+
+        // The vertex has an uneven degree?
+        if( (degree % 2) > 0 )
+        {
+            // Now that we've encountered a vertex with uneven degree,
+            // it must be a start or end vertex (as long as there're only two of these vertices).
+            unevenDegreeCount++;
+
+            // Found the first vertex with uneven degrree?
+            if( unevenDegreeCount == 1 )
+            {
+                graphInfo.graphType = GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE;
+
+                // This vertex will be a possible start or end vertex of the eulerian path.
+                graphInfo.startOrEndVertexNum1 = currVertexNum;
+            }
+            // Found the second vertex with uneven degrree?
+            else if( unevenDegreeCount == 2 )
+            {
+                // This vertex will be another possible start or end vertex of the eulerian path.
+                graphInfo.startOrEndVertexNum2 = currVertexNum;
+            }
+            // Found more than 2 vertices with uneven degree?
+            else
+            {
+                graphInfo.graphType = GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE;
+                // We reset these values because they wouldn't make sense now.
+                graphInfo.startOrEndVertexNum1 = VERTEX_UNDEFINED;
+                graphInfo.startOrEndVertexNum2 = VERTEX_UNDEFINED;
+                break;
+            }
+        }
+
+        // Update maximum degree.
+        if( degree > maxDegree )
+        {
+            maxDegree = degree;
+            vertexWithMaxDegree = currVertexNum;
+        }
+
+        // All vertices with edges must be in the same component as the first one.
+        // Vertices without edges don't matter.
+        if( components != NULL && degree > 0 )
+        {
+            int root = unionFind_find( components, currVertexNum );
+            if( componentRoot == VERTEX_UNDEFINED )
+                componentRoot = root;
+            else if( root != componentRoot )
+                disconnected = true;
+        }
+    }
+
+    // It could happen that we get a graph with no edges at all.
+    if( maxDegree <= 0 )
+        graphInfo.graphType = GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE;
+    else
+        graphInfo.vertexWithMaxDegree = vertexWithMaxDegree;
+
+    // The degrees would allow an eulerian path, but no path can get from one component to another.
+    if( disconnected && graphInfo.graphType != GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE )
+    {
+        graphInfo.graphType = GRAPH_TYPE_MORE_THAN_ONE_COMPONENT_WITH_EDGES;
+        graphInfo.startOrEndVertexNum1 = VERTEX_UNDEFINED;
+        graphInfo.startOrEndVertexNum2 = VERTEX_UNDEFINED;
+    }
+
+    return graphInfo;
+}
+
+
+int getStartVertexNum( GraphInformation graphInfo )
+{
+    if( graphInfo.graphType == GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
+        return graphInfo.startOrEndVertexNum1;
+
+    return graphInfo.vertexWithMaxDegree;
+}
+
+
+EulerianCycleResult findEulerianCycle( Graph *graph, GraphInformation graphInfo, ListBackend pathBackend )
+{
+    // The path's first element will be the start vertex.
+    int mergingVertexNum = getStartVertexNum( graphInfo );
+
+    // We start by extracting the first sub-circle of the graph as the base of our path.
+    // The path takes its memory from the same place as the graph.
+    Path *path = path_newWithAllocator( pathBackend, graph_getAllocator( graph ));
+    extractSubCircle( graph, mergingVertexNum, path );
+
+    // We go through each element of the current path and extract sub-circle-paths.
+    // Note that when we obtain a sub-circle, all edges where that path came along will be removed,
+    // so the graph keeps 'shrinking'.
+    // Every sub-circle-path is merged with the current path after we obtained it.
+    // We do this until we reached the end of our extending path and
+    // are not able to extract any further sub-circles.
+    //
+    // First create an iterator to go through the elements of the extending path.
+    PathIterator pathIterator;
+    pathIterator_toFirst( &pathIterator, path );
+
+    // Until we reached the end of the path.
+    while( !pathIterator_isAtEnd( &pathIterator, path ))
+    {
+        PathElement *currElement = pathIterator_get( &pathIterator, path );
+
+        // Get vertex number and degree of the vertex of the path where we want to merge the next sub-circle-path.
+        int mergingVertexNum = pathElement_getVertexNum( currElement );
+        int degree = graph_getDegree( graph, mergingVertexNum );
+
+        // We skip this obviously if there're no (more) edges at the current vertex.
+        if( degree > 0 )
+        {
+            // Extract a sub-circle-path. It must be able to be merged into our path.
+            Path *subCircle = path_newForMerging( path );
+            extractSubCircle( graph, mergingVertexNum, subCircle );
+
+            // Merge the current path with the sub-circle-path.
+            // This also gets rid of the sub-circle instance.
+            pathIterator_merge( &pathIterator, path, subCircle );
+        }
+
+        pathIterator_increment( &pathIterator, path );
+    }
+
+    // Assume that we found a path.
+    EulerianCycleResult result = { true, path };
+
+    // Now we have to check if there're no more edges inside the graph.
+    // This is important because it could be a disconnected graph
+    // which we haven't been able to recognize yet.
+    if( graph_hasEdges( graph ))
+    {
+        path_destroyAll( path );
+        result.exists = false;
+        result.eulerianCycle = NULL;
+    }
+
+    return result;
+}
+
+
+void extractSubCircle( Graph *graph, int startVertexNum, Path *subCircle )
+{
+    INSTRUMENT_COUNT( INSTRUMENT_SUB_CIRCLES );
+
+    // We append the first vertex to the sub-circle.
+    path_append( subCircle, startVertexNum );
+
+    // Setting start values.
+    int currVertexNum = startVertexNum;
+
+    // We only stop if there are no more edges left. Due to the condition that we had a graph whos vertices
+    // have an even degree, this happens on the start vertex. Only the first sub-circle of a path ends somewhere else.
+    while( graph_getDegree( graph, currVertexNum ) > 0 )
+    {
+        // Simply select the last edge to get to the next vertex.
+        // Removing the last edge of an array doesn't move any other edge.
+        int lastEdgeIndex = graph_getDegree( graph, currVertexNum ) - 1;
+        Edge *lastEdge = graph_getEdge( graph, currVertexNum, lastEdgeIndex );
+        int nextVertexNum = edge_getToVertexNum( lastEdge );
+
+        // Append the next vertex to the sub-circle.
+        path_append( subCircle, nextVertexNum );
+
+        // And now we remove the edges between the vertices so we won't take it again.
+        // Since we know where the edge is, this takes constant time.
+        graph_removeEdgePairAt( graph, currVertexNum, lastEdgeIndex );
+
+        // Finally we update the current vertex.
+        currVertexNum = nextVertexNum;
+    }
+
+    return;
+}
+
+
+EulerianCircuit findEulerianCircuit( Graph *graph, GraphInformation graphInfo )
+{
+    // A cycle along all edges visits one vertex more than it has edges, which also bounds the height of the stack.
+    EulerianCircuit circuit = { true, NULL, getEulerianCircuitLength( graph ) };
+    circuit.vertices = (int *) malloc( circuit.length * sizeof( int ));
+    int *stack = (int *) malloc( circuit.length * sizeof( int ));
+    assert( circuit.vertices != NULL && stack != NULL );
+
+    // The cycle is finished from its end, so we fill the array from the back.
+    size_t stackSize = 0;
+    size_t fillPosition = circuit.length;
+    stack[ stackSize++ ] = getStartVertexNum( graphInfo );
+
+    while( stackSize > 0 )
+    {
+        int currVertexNum = stack[ stackSize - 1 ];
+        int degree = graph_getDegree( graph, currVertexNum );
+
+        if( degree > 0 )
+        {
+            // Go along the last edge and remove it, just like 'extractSubCircle()' does.
+            int lastEdgeIndex = degree - 1;
+            int nextVertexNum = edge_getToVertexNum( graph_getEdge( graph, currVertexNum, lastEdgeIndex ));
+            graph_removeEdgePairAt( graph, currVertexNum, lastEdgeIndex );
+
+            // A disconnected graph can't push more vertices than we counted edges.
+            stack[ stackSize++ ] = nextVertexNum;
+        }
+        else
+        {
+            // We're stuck, so the vertex is done.
+            stackSize--;
+            circuit.vertices[ --fillPosition ] = currVertexNum;
+        }
+    }
+
+    free( stack );
+
+    // If there're edges left, the graph is disconnected.
+    if( graph_hasEdges( graph ))
+    {
+        free( circuit.vertices );
+        circuit.exists = false;
+        circuit.vertices = NULL;
+        circuit.length = 0;
+    }
+
+    return circuit;
+}
+
+
+size_t getEulerianCircuitLength( Graph *graph )
+{
+    // Every edge appears twice in the degrees.
+    const int *degrees = graph_getDegrees( graph );
+    size_t edgeCount = 0;
+    int vertexNum;
+    for( vertexNum = 0; vertexNum < graph_getVertexCount( graph ); vertexNum++ )
+        edgeCount += degrees[ vertexNum ];
+
+    return edgeCount / 2 + 1;
+}
+
+
+CircuitWorkspace *circuitWorkspace_new( void )
+{
+    CircuitWorkspace *workspace = (CircuitWorkspace *) malloc( sizeof( CircuitWorkspace ));
+    assert( workspace != NULL );
+
+    workspace->cursors = NULL;
+    workspace->cursorCapacity = 0;
+    workspace->usedEdgePairs = NULL;
+    workspace->usedEdgePairWordCapacity = 0;
+    workspace->stack = NULL;
+    workspace->stackCapacity = 0;
+
+    return workspace;
+}
+
+
+void circuitWorkspace_destroy( CircuitWorkspace *workspace )
+{
+    free( workspace->cursors );
+    free( workspace->usedEdgePairs );
+    free( workspace->stack );
+    free( workspace );
+    return;
+}
+
+
+/**
+ * @brief Makes sure that the arrays of the workspace are large enough for the graph. They never shrink.
+ */
+static void circuitWorkspace_reserve( CircuitWorkspace *workspace, int vertexCount, size_t wordCount, size_t stackCapacity )
+{
+    if( vertexCount > workspace->cursorCapacity )
+    {
+        workspace->cursorCapacity = vertexCount;
+        workspace->cursors = (int *) realloc( workspace->cursors, vertexCount * sizeof( int ));
+        assert( workspace->cursors != NULL );
+    }
+
+    if( wordCount > workspace->usedEdgePairWordCapacity )
+    {
+        workspace->usedEdgePairWordCapacity = wordCount;
+        workspace->usedEdgePairs = (uint64_t *) realloc( workspace->usedEdgePairs, wordCount * sizeof( uint64_t ));
+        assert( workspace->usedEdgePairs != NULL );
+    }
+
+    if( stackCapacity > workspace->stackCapacity )
+    {
+        workspace->stackCapacity = stackCapacity;
+        workspace->stack = (int *) realloc( workspace->stack, stackCapacity * sizeof( int ));
+        assert( workspace->stack != NULL );
+    }
+
+    return;
+}
+
+
+bool traceEulerianCircuit( Graph *graph, GraphInformation graphInfo, CircuitWorkspace *workspace, int *vertices, size_t length )
+{
+    // One bit per edge pair. Both edges of a pair share the handle, so marking one marks the other.
+    // A cycle along all edges visits one vertex more than it has edges, which also bounds the height of the stack.
+    int vertexCount = graph_getVertexCount( graph );
+    size_t wordCount = ( (size_t) graph_getEdgeHandleBound( graph ) + 63 ) / 64;
+    circuitWorkspace_reserve( workspace, vertexCount, wordCount, length );
+
+    // The cursor of a vertex is the number of its edges which haven't been looked at yet, counting from the front.
+    int *cursors = workspace->cursors;
+    if( vertexCount > 0 )
+        memcpy( cursors, graph_getDegrees( graph ), vertexCount * sizeof( int ));
+
+    uint64_t *usedEdgePairs = workspace->usedEdgePairs;
+    if( wordCount > 0 )
+        memset( usedEdgePairs, 0, wordCount * sizeof( uint64_t ));
+
+    int *stack = workspace->stack;
+    size_t stackSize = 0;
+    size_t fillPosition = length;
+    stack[ stackSize++ ] = getStartVertexNum( graphInfo );
+
+    while( stackSize > 0 )
+    {
+        int currVertexNum = stack[ stackSize - 1 ];
+        Edge *edges = graph_getEdges( graph, currVertexNum );
+
+        // Skip the edges whose pair has been used from the other side.
+        // Like the other algorithms, we take the edges from the back.
+        int *cursor = &cursors[ currVertexNum ];
+        Edge *edge = NULL;
+        while( *cursor > 0 )
+        {
+            edge = &edges[ --( *cursor ) ];
+            EdgeHandle handle = edge_getHandle( edge );
+            uint64_t bit = (uint64_t) 1 << ( handle % 64 );
+
+            if( !( usedEdgePairs[ handle / 64 ] & bit ))
+            {
+                usedEdgePairs[ handle / 64 ] |= bit;
+                break;
+            }
+
+            edge = NULL;
+        }
+
+        if( edge != NULL )
+        {
+            stack[ stackSize++ ] = edge_getToVertexNum( edge );
+        }
+        else
+        {
+            // We're stuck, so the vertex is done.
+            stackSize--;
+            vertices[ --fillPosition ] = currVertexNum;
+        }
+    }
+
+    // The cycle has one vertex more than it went along edges. If it's shorter, some edges couldn't be reached
+    // and the graph is disconnected.
+    return fillPosition == 0;
+}
+
+
+EulerianCircuit findEulerianCircuitNonDestructive( Graph *graph, GraphInformation graphInfo )
+{
+    EulerianCircuit circuit = { true, NULL, getEulerianCircuitLength( graph ) };
+    circuit.vertices = (int *) malloc( circuit.length * sizeof( int ));
+    assert( circuit.vertices != NULL );
+
+    CircuitWorkspace *workspace = circuitWorkspace_new();
+    circuit.exists = traceEulerianCircuit( graph, graphInfo, workspace, circuit.vertices, circuit.length );
+    circuitWorkspace_destroy( workspace );
+
+    if( !circuit.exists )
+    {
+        free( circuit.vertices );
+        circuit.vertices = NULL;
+        circuit.length = 0;
+    }
+
+    return circuit;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file hierholzer.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief The algorithms which check a graph and find an eulerian cycle or path in it.
+ */
+
+
+#ifndef HIERHOLZER
+#define HIERHOLZER
+
+
+#include "basic.h"
+#include "graph.h"
+#include "path.h"
+#include "unionfind.h"
+#include "stdint.h"
+
+
+/**
+ * @brief Just a simple flag which should indicate if a vertex number is not valid.
+ */
+#define VERTEX_UNDEFINED	-1
+
+
+/**
+ * @brief We have to categorize the input graph to see whether an eulerian path
+ * could potentially exist and whether it is a cycle or has to start at a vertex with uneven degree.
+ */
+typedef enum
+{
+    GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE,
+    GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE,
+    GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE,
+    GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE,
+    GRAPH_TYPE_MORE_THAN_ONE_COMPONENT_WITH_EDGES   /**< Only known if the components were found while loading. */
+} GraphType;
+
+
+/**
+ * @brief To evaluate the graph type, we have to walk over the vertices
+ * to get certain information which we store in this struct.
+ */
+typedef struct
+{
+    GraphType graphType;            /**< The graph type. */
+    int startOrEndVertexNum1;       /**< The first potential start or end vertex of an eulerian path. */
+    int startOrEndVertexNum2;       /**< The second potential start or end vertex of an eulerian path. */
+    int vertexWithMaxDegree;        /**< The vertex with max degree in the a graph. */
+} GraphInformation;
+
+
+/**
+ * @brief A structure that stores the output of the algorithm which tries to find an eulerian cycle in a graph.
+ */
+typedef struct
+{
+    bool exists;            /**< Tells if an eulerian cycle exists. */
+    Path *eulerianCycle;    /**< The result path. */
+} EulerianCycleResult;
+
+
+/**
+ * @brief The algorithms which can be used to find an eulerian cycle.
+ */
+typedef enum
+{
+    ENGINE_LIST_MERGING,    /**< Extracts sub-circles as paths and merges them into the result path. */
+    ENGINE_ITERATIVE,       /**< Walks the graph with a vertex stack and writes the cycle into an int array. */
+    ENGINE_NON_DESTRUCTIVE, /**< Like ENGINE_ITERATIVE but marks used edges in a bitmap instead of removing them. */
+    ENGINE_PARALLEL         /**< Pairs up the edges at every vertex and merges the resulting trails with many threads. */
+} Engine;
+
+
+/**
+ * @brief The output of the iterative algorithm: an eulerian cycle as a flat array of vertex numbers.
+ */
+typedef struct
+{
+    bool exists;            /**< Tells if an eulerian cycle exists. */
+    int *vertices;          /**< The vertex numbers of the cycle or path. The first and the last one are equal for a cycle. */
+    size_t length;          /**< The number of vertex numbers, which is the number of edges plus one. */
+} EulerianCircuit;
+
+
+/**
+ * @brief The arrays which 'traceEulerianCircuit()' needs besides the result.
+ * They grow with the graphs but are never shrunk, so solving many graphs with the same workspace
+ * doesn't allocate once the largest graph has been seen.
+ */
+typedef struct
+{
+    int *       cursors;                    /**< One cursor per vertex. */
+    int         cursorCapacity;             /**< The number of cursors which fit into the array. */
+    uint64_t *  usedEdgePairs;              /**< One bit per edge handle. */
+    size_t      usedEdgePairWordCapacity;   /**< The number of words which fit into the bitmap. */
+    int *       stack;                      /**< The vertices of the walk which aren't finished yet. */
+    size_t      stackCapacity;              /**< The number of vertices which fit onto the stack. */
+} CircuitWorkspace;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief This function goes through each vertex in a graph and creates the graph information.
+ * @param graph
+ * @param components The connected components of the graph or NULL.
+ * If they're given, a graph whose edges aren't all in the same component is recognized right away.
+ * Otherwise, the algorithms find out when they can't reach all edges.
+ * @return The graph information, which is used to evaluate whether there's potential for an
+ * eulerian path in a graph and needed for the following algorithms.
+ */
+GraphInformation checkVertexDegrees( Graph *graph, UnionFind *components );
+
+
+/**
+ * @brief Chooses the vertex where the algorithms start.
+ * An eulerian path of a graph with two vertices with uneven degree must start at one of them.
+ * In a graph where all vertices have even degree, any vertex with edges will do.
+ * @param graphInfo
+ * @return The vertex number of the start vertex.
+ */
+int getStartVertexNum( GraphInformation graphInfo );
+
+
+/**
+ * @brief This function will find an eulerian cycle in a graph where all vertices have even degrees,
+ * or an eulerian path in a graph where exactly two vertices have uneven degree.
+ * It uses the hierholzer algorithm to do that. A path starts at the first vertex with uneven degree
+ * and the first sub-circle simply ends where it gets stuck, which is the other one.
+ * All further sub-circles are closed since the remaining degrees are even.
+ * Since we're removing the edges from the graph, we can figure out easily if the graph is disconnected
+ * (in this case, an eulerian cycle/path doesn't exist).
+ * @param graph
+ * @param graphInfo
+ * @param pathBackend The backend of the resulting path.
+ * @return A result structure which stores an indicator whether an eulerian cycle exists and the final graph.
+ * The path takes its memory from the allocator of the graph.
+ */
+EulerianCycleResult findEulerianCycle( Graph *graph, GraphInformation graphInfo, ListBackend pathBackend );
+
+
+/**
+ * @brief A subroutine of the algorithm to find an eulerian cycle.
+ * This generates a sub-circle-path of the graph and removes the edges which belong to that path.
+ * It goes on until it reaches a vertex without edges. If all vertices have even degree, this can only be the start vertex.
+ * At every vertex it takes the edge which was added last and is still there, so removing it never moves another edge.
+ * @param graph
+ * @param startVertexNum
+ * @param subCircle An empty path which the sub-circle is appended to.
+ */
+void extractSubCircle( Graph *graph, int startVertexNum, Path *subCircle );
+
+
+/**
+ * @brief Finds an eulerian cycle like 'findEulerianCycle()' but without building any paths.
+ * It goes along unused edges and pushes every vertex it reaches onto a stack. When the vertex on top of the stack
+ * has no edges left, it is popped and becomes the next vertex of the cycle (counting from the end).
+ * Both the stack and the cycle are int arrays which are allocated once, so no step allocates memory.
+ * Just like 'findEulerianCycle()' the edges are removed from the graph.
+ * @param graph
+ * @param graphInfo
+ * @return The cycle. The vertex array must be freed by the caller.
+ */
+EulerianCircuit findEulerianCircuit( Graph *graph, GraphInformation graphInfo );
+
+
+/**
+ * @param graph
+ * @return The number of vertices of an eulerian cycle or path of the graph, which is the number of edges plus one.
+ */
+size_t getEulerianCircuitLength( Graph *graph );
+
+
+/**
+ * @brief Allocates and initializes a new workspace with empty arrays.
+ * @return The pointer to the new workspace.
+ */
+CircuitWorkspace *circuitWorkspace_new( void );
+
+
+/**
+ * @brief Frees the workspace and its arrays.
+ * @param workspace
+ */
+void circuitWorkspace_destroy( CircuitWorkspace *workspace );
+
+
+/**
+ * @brief Finds an eulerian cycle like 'findEulerianCircuit()' but leaves the edges of the graph alone,
+ * so the same graph can be solved again.
+ * Instead of removing edges, the used edge pairs are marked in a bitmap indexed by their handles,
+ * and every vertex has a cursor which moves backwards over its edge array and skips the used edges.
+ * So every edge is looked at a constant number of times.
+ * @param graph
+ * @param graphInfo
+ * @param workspace The arrays to work with. They're resized if the graph needs more.
+ * @param vertices Receives the vertex numbers of the cycle or path.
+ * @param length The number of vertex numbers to write, which must be 'getEulerianCircuitLength()'.
+ * @return true, if all edges have been reached. Otherwise the graph is disconnected and the vertices are incomplete.
+ */
+bool traceEulerianCircuit( Graph *graph, GraphInformation graphInfo, CircuitWorkspace *workspace, int *vertices, size_t length );
+
+
+/**
+ * @brief Finds an eulerian cycle with 'traceEulerianCircuit()' and a workspace of its own.
+ * @param graph
+ * @param graphInfo
+ * @return The cycle. The vertex array must be freed by the caller.
+ */
+EulerianCircuit findEulerianCircuitNonDestructive( Graph *graph, GraphInformation graphInfo );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // HIERHOLZER
@@ -0,0 +1,116 @@
+#include "instrument.h"
+#include "string.h"
+#include "time.h"
+
+
+#ifdef EULERIAN_INSTRUMENT
+
+
+bool instrument_isEnabled = false;
+uint64_t instrument_counters[ INSTRUMENT_COUNTER_COUNT ];
+
+
+/**
+ * @brief The names of the phases and counters in the JSON line.
+ */
+static const char *phaseNames[ INSTRUMENT_PHASE_COUNT ] = { "load_s", "check_s", "solve_s", "print_s", "teardown_s" };
+static const char *counterNames[ INSTRUMENT_COUNTER_COUNT ] =
+{
+    "sub_circles", "merges", "edge_pair_removals", "nodes_allocated", "nodes_freed", "chunks_allocated", "chunks_freed"
+};
+
+
+static double phaseStarts[ INSTRUMENT_PHASE_COUNT ];
+static double phaseTimes[ INSTRUMENT_PHASE_COUNT ];
+static double runStart;
+
+
+static double now( void )
+{
+    struct timespec time;
+    clock_gettime( CLOCK_MONOTONIC, &time );
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+
+void instrument_setUp( bool enable )
+{
+    const char *value = getenv( INSTRUMENT_ENVIRONMENT_VARIABLE );
+    instrument_isEnabled = enable || ( value != NULL && value[ 0 ] != '\0' && strcmp( value, "0" ) != 0 );
+    runStart = now();
+    return;
+}
+
+
+void instrument_begin( InstrumentPhase phase )
+{
+    phaseStarts[ phase ] = now();
+    return;
+}
+
+
+void instrument_end( InstrumentPhase phase )
+{
+    phaseTimes[ phase ] += now() - phaseStarts[ phase ];
+    return;
+}
+
+
+void instrument_report( void )
+{
+    if( !instrument_isEnabled )
+        return;
+
+    double total = now() - runStart;
+
+    // The line is assembled first, so it isn't torn apart by other output.
+    char line[ 1024 ];
+    int length = 0;
+    length += snprintf( line + length, sizeof( line ) - length, "{" );
+
+    int phase;
+    for( phase = 0; phase < INSTRUMENT_PHASE_COUNT; phase++ )
+        length += snprintf( line + length, sizeof( line ) - length, "\"%s\":%.6f,", phaseNames[ phase ], phaseTimes[ phase ] );
+    length += snprintf( line + length, sizeof( line ) - length, "\"total_s\":%.6f", total );
+
+    int counter;
+    for( counter = 0; counter < INSTRUMENT_COUNTER_COUNT; counter++ )
+        length += snprintf( line + length, sizeof( line ) - length, ",\"%s\":%llu", counterNames[ counter ],
+                            (unsigned long long) __atomic_load_n( &instrument_counters[ counter ], __ATOMIC_RELAXED ));
+
+    fprintf( stderr, "%s}\n", line );
+    return;
+}
+
+
+#else
+
+
+void instrument_setUp( bool enable )
+{
+    (void) enable;
+    return;
+}
+
+
+void instrument_begin( InstrumentPhase phase )
+{
+    (void) phase;
+    return;
+}
+
+
+void instrument_end( InstrumentPhase phase )
+{
+    (void) phase;
+    return;
+}
+
+
+void instrument_report( void )
+{
+    return;
+}
+
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file instrument.h
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief Optional timings of the phases of a run and counters of expensive operations.
+ *
+ * The instrumentation is only compiled in if EULERIAN_INSTRUMENT is defined, which the makefile does
+ * unless it's called with INSTRUMENT=0. Without it, the macros are empty and the functions do nothing.
+ * With it, nothing is recorded either until 'instrument_setUp()' enables it, so a counter costs a
+ * predictable branch when it's disabled.
+ */
+
+
+#ifndef INSTRUMENT
+#define INSTRUMENT
+
+
+#include "basic.h"
+#include "stdint.h"
+
+
+/**
+ * @brief The name of the environment variable which enables the instrumentation if it's set to anything but "0".
+ */
+#define INSTRUMENT_ENVIRONMENT_VARIABLE     "EULERIAN_STATS"
+
+
+/**
+ * @brief The phases of a run whose wall times are recorded.
+ */
+typedef enum
+{
+    INSTRUMENT_PHASE_LOAD,                  /**< Reading the file and building the graph. */
+    INSTRUMENT_PHASE_CHECK,                 /**< Checking the vertex degrees. */
+    INSTRUMENT_PHASE_SOLVE,                 /**< Finding the cycle or path. */
+    INSTRUMENT_PHASE_PRINT,                 /**< Writing the result. */
+    INSTRUMENT_PHASE_TEARDOWN,              /**< Destroying the graph and the path. */
+    INSTRUMENT_PHASE_COUNT
+} InstrumentPhase;
+
+
+/**
+ * @brief The operations which are counted.
+ */
+typedef enum
+{
+    INSTRUMENT_SUB_CIRCLES,                 /**< Calls of 'extractSubCircle()'. */
+    INSTRUMENT_MERGES,                      /**< Sub-circles spliced into a path by one of the list merge functions. */
+    INSTRUMENT_EDGE_PAIR_REMOVALS,          /**< Edge pairs removed from a graph. */
+    INSTRUMENT_NODES_ALLOCATED,             /**< Linked list nodes allocated, from a pool or with malloc. */
+    INSTRUMENT_NODES_FREED,                 /**< Linked list nodes freed one by one. Nodes go away with their pool uncounted. */
+    INSTRUMENT_CHUNKS_ALLOCATED,            /**< Unrolled list chunks allocated. */
+    INSTRUMENT_CHUNKS_FREED,                /**< Unrolled list chunks freed. */
+    INSTRUMENT_COUNTER_COUNT
+} InstrumentCounter;
+
+
+#ifdef EULERIAN_INSTRUMENT
+
+/**
+ * @brief true, if the instrumentation records anything. Only 'instrument_setUp()' changes it.
+ */
+extern bool instrument_isEnabled;
+
+/**
+ * @brief The counters, indexed by InstrumentCounter.
+ */
+extern uint64_t instrument_counters[ INSTRUMENT_COUNTER_COUNT ];
+
+/**
+ * @brief Counts an operation. Threads may count at the same time.
+ */
+#define INSTRUMENT_COUNT( counter ) \
+    do { if( instrument_isEnabled ) __atomic_fetch_add( &instrument_counters[ counter ], 1, __ATOMIC_RELAXED ); } while( 0 )
+
+/**
+ * @brief Starts the clock of a phase.
+ */
+#define INSTRUMENT_BEGIN( phase ) \
+    do { if( instrument_isEnabled ) instrument_begin( phase ); } while( 0 )
+
+/**
+ * @brief Stops the clock of a phase and adds the time since 'INSTRUMENT_BEGIN()' to it.
+ */
+#define INSTRUMENT_END( phase ) \
+    do { if( instrument_isEnabled ) instrument_end( phase ); } while( 0 )
+
+#else
+
+#define INSTRUMENT_COUNT( counter )     do { } while( 0 )
+#define INSTRUMENT_BEGIN( phase )       do { } while( 0 )
+#define INSTRUMENT_END( phase )         do { } while( 0 )
+
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Enables the instrumentation if it's asked for by the program option or by the environment variable.
+ * It must be called before any other thread is started.
+ * @param enable true, if the program option was given.
+ */
+void instrument_setUp( bool enable );
+
+
+/**
+ * @brief Starts the clock of a phase. Use 'INSTRUMENT_BEGIN()' instead.
+ * @param phase
+ */
+void instrument_begin( InstrumentPhase phase );
+
+
+/**
+ * @brief Stops the clock of a phase. Use 'INSTRUMENT_END()' instead.
+ * @param phase
+ */
+void instrument_end( InstrumentPhase phase );
+
+
+/**
+ * @brief Writes the phase times in seconds and the counters as one JSON line to stderr, if the instrumentation is enabled.
+ */
+void instrument_report( void );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // INSTRUMENT
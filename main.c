@@ -7,14 +7,26 @@
 
 
 #include "string.h"
+#include "limits.h"
+#include "unistd.h"
 #include "basic.h"
 #include "edge.h"
-#include "vertex.h"
 #include "graph.h"
 #include "path.h"
 #include "pathelement.h"
+#include "pathiterator.h"
+#include "edgelist.h"
+#include "csrgraph.h"
+#include "unionfind.h"
+#include "outputwriter.h"
+#include "hierholzer.h"
+#include "parallelcircuit.h"
+#include "batch.h"
+#include "instrument.h"
+#include "server.h"
 #include "dlistiterator.h"
-#include "comparator.h"
+#include "arenaallocator.h"
+#include "eulerian.h"
 
 
 /**
@@ -23,49 +35,6 @@
 #define NDEBUG
 
 
-/**
- * @brief Just a simple flag which should indicate if a vertex number is not valid.
- */
-#define VERTEX_UNDEFINED	-1
-
-
-/**
- * @brief We have to categorize the input graph to see whether an eulerian path
- * could potentially exist or whether we have to convert the graph so that we can use
- * the algorithm to find an eulerian cycle first and print an eulerian path afterwards.
- */
-typedef enum
-{
-    GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE,
-    GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE,
-    GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE,
-    GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE
-} GraphType;
-
-
-/**
- * @brief To evaluate the graph type, we have to walk over the vertices
- * to get certain information which we store in this struct.
- */
-typedef struct
-{
-    GraphType graphType;            /**< The graph type. */
-    int startOrEndVertexNum1;       /**< The first potential start or end vertex of an eulerian path. */
-    int startOrEndVertexNum2;       /**< The second potential start or end vertex of an eulerian path. */
-    int vertexWithMaxDegree;        /**< The vertex with max degree in the a graph. */
-} GraphInformation;
-
-
-/**
- * @brief A structure that stores the output of the algorithm which tries to find an eulerian cycle in a graph.
- */
-typedef struct
-{
-    bool exists;            /**< Tells if an eulerian cycle exists. */
-    Path *eulerianCycle;    /**< The result path. */
-} EulerianCycleResult;
-
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -77,69 +46,42 @@ extern "C" {
  * In the first line, there must be exactly one integer which represents the vertex count.
  * In each following line there must be exactly two intergers which represent a pair of edges,
  * between the first number (=vertex 1) and the second number (=vertex 2).
+ * The file is mapped into memory and parsed by the edge list scanner, which reports the line and column of errors.
+ * Binary graph files (see 'csrGraph_save()') are recognized by their header and used without parsing.
  * @param filename
+ * @param threadCount The number of threads which parse the file.
+ * @param components If not NULL, it receives a union-find of the vertices which is built from the edges while they're read,
+ * so the connected components are known before any algorithm runs. It must be destroyed by the caller.
+ * @param allocator The allocator of the graph or NULL for the default allocator.
  * @return The pointer to the created graph if it there're no problems with the file, else NULL.
  */
-Graph *loadGraph( char *filename );
-
-
-/**
- * @brief This function goes through each vertex in a graph and creates the graph information.
- * @param graph
- * @return The graph information, which is used to evaluate whether there's potential for an
- * eulerian path in a graph and needed for the following algorithms.
- */
-GraphInformation checkVertexDegrees( Graph *graph );
+Graph *loadGraph( char *filename, int threadCount, UnionFind **components, const Allocator *allocator );
 
 
 /**
- * @brief We know an algorithm to find an eulerian cycle in a graph where all vertices
- * have even degree. However, this may not work on a graph where only two vertices have uneven degree which
- * is the criteria for finding an eulerian path. So having a graph where only two vertices have uneven degree,
- * we simply convert it to a graph with completely even degrees by adding a new vertex to the graph and connecting
- * the two vertices with uneven degree to that new vertex. Now we can find an eulerian cycle and later
- * when we want to print it, we can simply ommit the added vertex.
- * @param graph
- * @param graphInfo
+ * @brief Converts a graph from the text format into a binary graph file.
+ * Errors are printed to stderr.
+ * @param filename The text file.
+ * @param binaryFilename The binary file to write.
+ * @param threadCount The number of threads which parse the text file.
  */
-void convertGraph( Graph *graph, GraphInformation graphInfo );
+void saveBinaryGraph( char *filename, char *binaryFilename, int threadCount );
 
 
 /**
- * @brief This function will find an eulerian cycle in a graph where all vertices have even degrees.
- * It uses the hierholzer algorithm to do that.
- * Since we're removing the edges from the graph, we can figure out easily if the graph is disconnected
- * (in this case, an eulerian cycle/path doesn't exist).
- * @param graph
- * @param graphInfo
- * @return A result structure which stores an indicator whether an eulerian cycle exists and the final graph.
- */
-EulerianCycleResult findEulerianCycle( Graph *graph, GraphInformation graphInfo );
-
-
-/**
- * @brief A subroutine of the algorithm to find an eulerian cycle.
- * This generates a sub-circle-path of the graph and removes the edges which belong to that path.
- * @param graph
- * @param startVertexNum
- * @return The extracted sub-circle-path.
- */
-Path *extractSubCircle( Graph *graph, int startVertexNum );
-
-
-/**
- * @brief Prints an eulerian cycle.
+ * @brief Prints an eulerian cycle or path.
+ * @param output
  * @param eulerianCycle
  */
-void printEulerianCycle( Path *eulerianCycle );
+void printEulerianCycle( OutputWriter *output, Path *eulerianCycle );
 
 
 /**
- * @brief Prints an eulerian path.
- * @param eulerianCylce
- * @param addedVertexNum
+ * @brief Prints an eulerian cycle or path which was found by 'findEulerianCircuit()'.
+ * @param output
+ * @param circuit
  */
-void printEulerianPath( Path *eulerianCylce, int addedVertexNum );
+void printEulerianCircuit( OutputWriter *output, EulerianCircuit circuit );
 
 
 #ifdef __cplusplus
@@ -150,12 +92,167 @@ void printEulerianPath( Path *eulerianCylce, int addedVertexNum );
 int main( int argc, char *argv[] )
 {
     Graph *graph;
+    ListBackend listBackend = LIST_BACKEND_LINKED;
+    Engine engine = ENGINE_LIST_MERGING;
+    int threadCount = 1;
+    char *binaryFilename = NULL;
+    char *outputFilename = NULL;
+    UnionFind *components = NULL;
+    bool findComponents = false;
+    bool batchMode = false;
+    bool statsRequested = false;
+    char *socketPath = NULL;
+    size_t cacheMegabytes = 0;
+    size_t requestMegabytes = 0;
+    char *cacheDirectory = NULL;
+    EulerianMemory memory = EULERIAN_MEMORY_HEAP;
+    ArenaAllocator *arena = NULL;
+
+    // Parse the options:
+    // '-u' stores the paths in unrolled lists instead of linked lists.
+    // '-i' uses the iterative algorithm instead of merging paths.
+    // '-n' uses the iterative algorithm without removing edges from the graph.
+    // '-p' finds the path with '-t' threads by merging trails, which leaves the graph alone as well.
+    // '-k' finds the connected components while loading and rejects disconnected graphs before searching.
+    // '-a' keeps the graph and the path in an arena, which is released at once instead of vertex by vertex.
+    // '-A' does the same with an arena which is backed by huge pages where the system supports them.
+    // '-v' writes the time of each phase and some counters as a JSON line to stderr, like EULERIAN_STATS=1 does.
+    // '-b' treats the file as a manifest or directory of graph files and solves all of them.
+    // '-t <count>' parses the file and finds the path with this many threads, or solves this many files at once in batch mode.
+    // '-c <file>' converts the graph into a binary graph file instead of searching a path.
+    // '-o <file>' writes the result into a file instead of stdout.
+    // '-s <socket>' stays resident and solves the graphs submitted over this socket with '-t' workers.
+    // '-m <megabytes>' lets the server keep this many megabytes of results of earlier submissions.
+    // '-d <directory>' lets the server store results in this directory as well, so they survive a restart.
+    // '-r <megabytes>' lets the server accept requests up to this size instead of SERVER_DEFAULT_MAX_REQUEST_SIZE.
+    int option;
+    while(( option = getopt( argc, argv, "uinpkaAvbt:c:o:s:m:d:r:" )) != -1 )
+    {
+        switch( option )
+        {
+        case 'c':
+            binaryFilename = optarg;
+            break;
+        case 'o':
+            outputFilename = optarg;
+            break;
+        case 's':
+            socketPath = optarg;
+            break;
+        case 'm':
+            cacheMegabytes = (size_t) atol( optarg );
+            if( cacheMegabytes < 1 )
+            {
+                fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+                return 0;
+            }
+            break;
+        case 'd':
+            cacheDirectory = optarg;
+            break;
+        case 'r':
+            requestMegabytes = (size_t) atol( optarg );
+            if( requestMegabytes < 1 )
+            {
+                fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+                return 0;
+            }
+            break;
+        case 'u':
+            listBackend = LIST_BACKEND_UNROLLED;
+            break;
+        case 'i':
+            engine = ENGINE_ITERATIVE;
+            break;
+        case 'n':
+            engine = ENGINE_NON_DESTRUCTIVE;
+            break;
+        case 'p':
+            engine = ENGINE_PARALLEL;
+            break;
+        case 'k':
+            findComponents = true;
+            break;
+        case 'a':
+            memory = EULERIAN_MEMORY_ARENA;
+            break;
+        case 'A':
+            memory = EULERIAN_MEMORY_HUGE_PAGES;
+            break;
+        case 'v':
+            statsRequested = true;
+            break;
+        case 'b':
+            batchMode = true;
+            break;
+        case 't':
+            threadCount = atoi( optarg );
+            if( threadCount < 1 )
+            {
+                fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+                return 0;
+            }
+            break;
+        default:
+            fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+            return 0;
+        }
+    }
 
-    // Check argument size: we specified that the first argument is the filename to our graph data.
-    if( argc >= 2 )
+    instrument_setUp( statsRequested );
+
+    // The server doesn't take a graph file, clients submit the graphs.
+    if( socketPath != NULL )
     {
+        // A disk store alone still gets a memory cache in front of it.
+        ResultCache *cache = NULL;
+        if( cacheMegabytes > 0 || cacheDirectory != NULL )
+            cache = resultCache_new(( cacheMegabytes > 0 ? cacheMegabytes : RESULTCACHE_DEFAULT_MEGABYTES ) << 20, cacheDirectory );
+
+        // The cache isn't destroyed, since workers may still be finishing a job until the process ends.
+        if( !server_run( socketPath, threadCount, requestMegabytes << 20, cache, memory ))
+            fprintf( stderr, "Konnte %s nicht oeffnen\n", socketPath );
+
+        instrument_report();
+        return 0;
+    }
+
+    // Check argument size: we specified that the first argument after the options is the filename to our graph data.
+    if( optind < argc && batchMode )
+    {
+        OutputWriter *output = ( outputFilename != NULL ) ? outputWriter_open( outputFilename ) : outputWriter_new( STDOUT_FILENO );
+        if( output == NULL )
+        {
+            fprintf( stderr, "Konnte %s nicht schreiben\n", outputFilename );
+            return 0;
+        }
+
+        if( !batch_run( argv[ optind ], threadCount, memory, output ))
+            fprintf( stderr, "Konnte %s nicht lesen\n", argv[ optind ] );
+
+        if( !outputWriter_destroy( output ))
+            fprintf( stderr, "Konnte %s nicht schreiben\n", outputFilename != NULL ? outputFilename : "stdout" );
+
+        instrument_report();
+        return 0;
+    }
+    else if( optind < argc && binaryFilename != NULL )
+    {
+        saveBinaryGraph( argv[ optind ], binaryFilename, threadCount );
+        return 0;
+    }
+    else if( optind < argc )
+    {
+        if( memory == EULERIAN_MEMORY_HUGE_PAGES )
+            arena = arenaAllocator_newWithHugePages( 0 );
+        else if( memory == EULERIAN_MEMORY_ARENA )
+            arena = arenaAllocator_new( NULL, 0 );
+
         // load graph
-        graph = loadGraph( argv[1] );
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_LOAD );
+        graph = loadGraph( argv[ optind ], threadCount, findComponents ? &components : NULL,
+                           arena != NULL ? arenaAllocator_get( arena ) : NULL );
+        INSTRUMENT_END( INSTRUMENT_PHASE_LOAD );
     }
     else
     {
@@ -167,345 +264,261 @@ int main( int argc, char *argv[] )
     if( graph == NULL )
         return 0;
 
+    // All results go through a buffered writer.
+    OutputWriter *output = ( outputFilename != NULL ) ? outputWriter_open( outputFilename ) : outputWriter_new( STDOUT_FILENO );
+    if( output == NULL )
+    {
+        fprintf( stderr, "Konnte %s nicht schreiben\n", outputFilename );
+        if( arena != NULL )
+            arenaAllocator_destroy( arena );
+        else
+            graph_destroyAll( graph );
+        return 0;
+    }
+
     // Now that we have the graph in memory, we check if we canNOT find an eulerian path.
     // It has no eulerian path if more than two vertices have an uneven degree.
-    GraphInformation graphInfo = checkVertexDegrees( graph );
+    // With the components at hand, we also know if the edges are disconnected.
+    INSTRUMENT_BEGIN( INSTRUMENT_PHASE_CHECK );
+    GraphInformation graphInfo = checkVertexDegrees( graph, components );
+    INSTRUMENT_END( INSTRUMENT_PHASE_CHECK );
     bool proceed = true;
 
+    if( components != NULL )
+        unionFind_destroy( components );
+
     if( graphInfo.graphType != GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE &&
         graphInfo.graphType != GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
     {
-        if( graphInfo.graphType == GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE )
+        if( graphInfo.graphType == GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE ||
+            graphInfo.graphType == GRAPH_TYPE_MORE_THAN_ONE_COMPONENT_WITH_EDGES )
         {
-            printf( "-1" );
+            outputWriter_writeString( output, "-1" );
         }
 
-        printf( "\n" );
+        outputWriter_writeChar( output, '\n' );
 
         proceed = false;
     }
 
     // Now there's potential for an eulerian cycle but we cannot be completely sure because the graph must also be connected.
     // However, there might be some vertices that do not have any edges - which is valid. Our algorithm handles that.
-    if( proceed )
+    if( proceed && engine != ENGINE_LIST_MERGING )
     {
-        EulerianCycleResult eulerianCycleResult = findEulerianCycle( graph, graphInfo );
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_SOLVE );
+        EulerianCircuit circuit;
+        if( engine == ENGINE_ITERATIVE )
+            circuit = findEulerianCircuit( graph, graphInfo );
+        else if( engine == ENGINE_PARALLEL )
+            circuit = findEulerianCircuitParallel( graph, graphInfo, threadCount );
+        else
+            circuit = findEulerianCircuitNonDestructive( graph, graphInfo );
+        INSTRUMENT_END( INSTRUMENT_PHASE_SOLVE );
+
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_PRINT );
+        if( circuit.exists )
+            printEulerianCircuit( output, circuit );
+        else
+            outputWriter_writeString( output, "-1" );
+
+        outputWriter_writeChar( output, '\n' );
+        INSTRUMENT_END( INSTRUMENT_PHASE_PRINT );
+
+        free( circuit.vertices );
+    }
+    else if( proceed )
+    {
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_SOLVE );
+        EulerianCycleResult eulerianCycleResult = findEulerianCycle( graph, graphInfo, listBackend );
+        INSTRUMENT_END( INSTRUMENT_PHASE_SOLVE );
 
         // Outputting.
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_PRINT );
         if( eulerianCycleResult.exists )
-        {
-            if( graphInfo.graphType == GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
-            {
-                // We have to specify the vertex number of the added vertex which is always the last vertex.
-                printEulerianPath( eulerianCycleResult.eulerianCycle, graph->vertexCount - 1 );
-            }
-            else
-            {
-                printEulerianCycle( eulerianCycleResult.eulerianCycle );
-            }
-        }
+            printEulerianCycle( output, eulerianCycleResult.eulerianCycle );
         else
-        {
-            printf( "-1" );
-        }
+            outputWriter_writeString( output, "-1" );
 
-        printf( "\n" );
+        outputWriter_writeChar( output, '\n' );
+        INSTRUMENT_END( INSTRUMENT_PHASE_PRINT );
 
-        // Destroy complete the path.
-        path_destroyAll( eulerianCycleResult.eulerianCycle );
+        // Destroy complete the path. In an arena, it goes away together with the graph.
+        INSTRUMENT_BEGIN( INSTRUMENT_PHASE_TEARDOWN );
+        if( eulerianCycleResult.eulerianCycle != NULL && arena == NULL )
+            path_destroyAll( eulerianCycleResult.eulerianCycle );
+        INSTRUMENT_END( INSTRUMENT_PHASE_TEARDOWN );
     }
 
-    // Destroy the complete graph.
-    graph_destroyAll( graph );
+    // Write what's left in the buffer.
+    INSTRUMENT_BEGIN( INSTRUMENT_PHASE_PRINT );
+    if( !outputWriter_destroy( output ))
+        fprintf( stderr, "Konnte %s nicht schreiben\n", outputFilename != NULL ? outputFilename : "stdout" );
+    INSTRUMENT_END( INSTRUMENT_PHASE_PRINT );
+
+    // Destroy the complete graph. An arena releases it block by block instead of vertex by vertex.
+    INSTRUMENT_BEGIN( INSTRUMENT_PHASE_TEARDOWN );
+    if( arena != NULL )
+        arenaAllocator_destroy( arena );
+    else
+        graph_destroyAll( graph );
+    INSTRUMENT_END( INSTRUMENT_PHASE_TEARDOWN );
 
+    instrument_report();
     return 0;
 }
 
 
-Graph *loadGraph( char *filename )
+Graph *loadGraph( char *filename, int threadCount, UnionFind **components, const Allocator *allocator )
 {
-    // Opening the file.
-    FILE *f = fopen( filename, "r" );
-    if( f == NULL )
+    // Binary graph files are mapped and copied into the graph right away.
+    CsrGraphFileStatus status;
+    CsrGraph *csrGraph = csrGraph_load( filename, &status );
+    if( csrGraph != NULL )
     {
-        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
-        return NULL;
-    }
-
-    // We start by reading the number of vertices.
-    int vertexCount;
-    if( fscanf( f, "%d\n", &vertexCount ) != 1 )
-    {
-        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
-        return NULL;
-    }
-
-    // Create the graph.
-    Graph *graph = graph_new( vertexCount );
-
-    // Now we are creating the edges by reading the file.
-    // An edge in a file is a line with two deciaml numbers seperated by a whitespace.
-    //
-    // Make sure we read exactly 2 decimal in each line.
-    int vertexNum1, vertexNum2;
-    while( fscanf( f, "%d %d\n", &vertexNum1, &vertexNum2 ) == 2 )
-    {
-        if( vertexNum1 >= vertexCount || vertexNum2 >= vertexCount )
+        // Handles and degrees are ints, so a graph can't hold more edge pairs than this.
+        if( (size_t) csrGraph_getEdgePairCount( csrGraph ) > GRAPH_MAX_EDGE_PAIR_COUNT )
         {
             fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+            csrGraph_destroy( csrGraph );
             return NULL;
         }
 
-        // Create one edge going from vertex 1 to vertex 2
-        // and one edge going from vertex 2 to vertex 1.
-        graph_addEdgePair( graph, vertexNum1, vertexNum2 );
-    }
+        Graph *graph = graph_newFromCsrWithAllocator( csrGraph, allocator );
 
-    fclose( f );
-
-    return graph;
-}
-
-
-GraphInformation checkVertexDegrees( Graph *graph )
-{
-    // We're optimistic and assume that two or less vertices with uneven degree at the beginning.
-    GraphInformation graphInfo = {
-            GRAPH_TYPE_NO_VERTICES_WITH_UNEVEN_DEGREE,
-            VERTEX_UNDEFINED,
-            VERTEX_UNDEFINED,
-            VERTEX_UNDEFINED
-    };
-    int unevenDegreeCount = 0;
-    int maxDegree = 0;
-    int vertexWithMaxDegree = VERTEX_UNDEFINED;
-
-    // Loop through every vertex
-    int currVertexNum;
-    for( currVertexNum = 0; currVertexNum < graph_getVertexCount( graph ); currVertexNum++ )
-    {
-        int degree = vertex_getDegree( graph_getVertex( graph, currVertexNum ));
-
-        // The vertex has an uneven degree?
-        if( (degree % 2) > 0 )
+        // Every edge pair appears in both rows, so we only unite along the half-edges which point forward.
+        if( components != NULL )
         {
-            // Now that we've encountered a vertex with uneven degree,
-            // it must be a start or end vertex (as long as there're only two of these vertices).
-            unevenDegreeCount++;
+            *components = unionFind_new( csrGraph_getVertexCount( csrGraph ));
 
-            // Found the first vertex with uneven degrree?
-            if( unevenDegreeCount == 1 )
-            {
-                graphInfo.graphType = GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE;
-
-                // This vertex will be a possible start or end vertex of the eulerian path.
-                graphInfo.startOrEndVertexNum1 = currVertexNum;
-            }
-            // Found the second vertex with uneven degrree?
-            else if( unevenDegreeCount == 2 )
-            {
-                // This vertex will be another possible start or end vertex of the eulerian path.
-                graphInfo.startOrEndVertexNum2 = currVertexNum;
-            }
-            // Found more than 2 vertices with uneven degree?
-            else
+            int vertexNum;
+            for( vertexNum = 0; vertexNum < csrGraph_getVertexCount( csrGraph ); vertexNum++ )
             {
-                graphInfo.graphType = GRAPH_TYPE_MORE_THAN_TWO_VERTICES_WITH_UNEVEN_DEGREE;
-                // We reset these values because they wouldn't make sense now.
-                graphInfo.startOrEndVertexNum1 = VERTEX_UNDEFINED;
-                graphInfo.startOrEndVertexNum2 = VERTEX_UNDEFINED;
-                break;
+                int edgeIndex = csrGraph_getFirstEdge( csrGraph, vertexNum );
+                int lastEdgeIndex = edgeIndex + csrGraph_getDegree( csrGraph, vertexNum );
+                for( ; edgeIndex < lastEdgeIndex; edgeIndex++ )
+                {
+                    if( csrGraph_getCorrespondingEdge( csrGraph, edgeIndex ) > edgeIndex )
+                        unionFind_unite( *components, vertexNum, csrGraph_getToVertexNum( csrGraph, edgeIndex ));
+                }
             }
         }
 
-        // Update maximum degree.
-        if( degree > maxDegree )
-        {
-            maxDegree = degree;
-            vertexWithMaxDegree = currVertexNum;
-        }
+        csrGraph_destroy( csrGraph );
+        return graph;
+    }
+    else if( status == CSRGRAPH_FILE_UNREADABLE )
+    {
+        fprintf( stderr, "Konnte %s nicht lesen\n", filename );
+        return NULL;
+    }
+    else if( status != CSRGRAPH_FILE_NOT_BINARY )
+    {
+        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+        return NULL;
     }
 
-    // It could happen that we get a graph with no edges at all.
-    if( maxDegree <= 0 )
-        graphInfo.graphType = GRAPH_TYPE_ALL_VERTICES_WITH_ZERO_DEGREE;
-    else
-        graphInfo.vertexWithMaxDegree = vertexWithMaxDegree;
-
-    return graphInfo;
-}
-
-
-void convertGraph( Graph *graph, GraphInformation graphInfo )
-{
-    graph_addVertex( graph );
-
-    // Add the edges between the possible start or end vertices and the new vertex.
-    int addedVertexNum = graph_getVertexCount( graph ) - 1;
-    graph_addEdgePair( graph, addedVertexNum, graphInfo.startOrEndVertexNum1 );
-    graph_addEdgePair( graph, addedVertexNum, graphInfo.startOrEndVertexNum2 );
-
-    return;
-}
-
-
-EulerianCycleResult findEulerianCycle( Graph *graph, GraphInformation graphInfo )
-{
-    // If the graph has two vertices with uneven degree, we add an edge between those so that we can find an eulerian cycle.
-    if( graphInfo.graphType == GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
-       convertGraph( graph, graphInfo );
-
-    // The path's first element will be the vertex with the max degree.
-    int mergingVertexNum = graphInfo.vertexWithMaxDegree;
-
-    // We start by extracting the first sub-circle of the graph as the base of our path.
-    Path *path = extractSubCircle( graph, mergingVertexNum );
-
-    // We go through each element of the current path and extract sub-circle-paths.
-    // Note that when we obtain a sub-circle, all edges where that path came along will be removed,
-    // so the graph keeps 'shrinking'.
-    // Every sub-circle-path is merged with the current path after we obtained it.
-    // We do this until we reached the end of our extending path and
-    // are not able to extract any further sub-circles.
-    //
-    // First create an iterator to go through the elements of the extending path.
-    DList *pathElements = path_getElements( path );
-    DListIterator *pathIterator = dListIterator_getIteratorFromList( pathElements );
-
-    // Until we reached the end of the path.
-    while( !dListIterator_isAtEnd( pathIterator, pathElements ))
+    // Everything else is a text file: parse the whole file into an array of edge pairs.
+    EdgeListError error;
+    EdgeList *edgeList = edgeList_load( filename, threadCount, &error );
+    if( edgeList == NULL )
     {
-        PathElement *currElement = (PathElement *) dListIterator_get( pathIterator );
+        if( error.line > 0 )
+            fprintf( stderr, "Ungueltiges Eingabeformat (Zeile %d, Spalte %d: %s)\n", error.line, error.column, error.message );
+        else
+            fprintf( stderr, "Konnte %s nicht lesen\n", filename );
+        return NULL;
+    }
 
-        // Get vertex number and degree of the vertex of the path where we want to merge the next sub-circle-path.
-        int mergingVertexNum = pathElement_getVertexNum( currElement );
-        int degree = vertex_getDegree( graph_getVertex( graph, mergingVertexNum ));
+    // Handles and degrees are ints, so a graph can't hold more edge pairs than this.
+    if( edgeList->edgePairCount > GRAPH_MAX_EDGE_PAIR_COUNT )
+    {
+        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+        edgeList_destroy( edgeList );
+        return NULL;
+    }
 
-        // We skip this obviously if there're no (more) edges at the current vertex.
-        if( degree > 0 )
-        {
-            // Extract a sub-circle-path.
-            Path *subCircle = extractSubCircle( graph, mergingVertexNum );
+    // Create the graph.
+    Graph *graph = graph_newWithAllocator( edgeList->vertexCount, allocator );
 
-            // Merge the current path with the sub-circle-path.
-            dListIterator_merge( &pathIterator, pathElements, path_getElements( subCircle ));
+    // Create one edge going from vertex 1 to vertex 2
+    // and one edge going from vertex 2 to vertex 1 for every pair in the file.
+    graph_addEdgePairs( graph, edgeList->edgePairs, edgeList->edgePairCount );
 
-            // Since we have merged the paths, we can get rid of the sub-circle instance.
-            path_destroy( subCircle );
-        }
+    // Unite the two vertices of every pair, so each set of the union-find is a connected component.
+    if( components != NULL )
+    {
+        *components = unionFind_new( edgeList->vertexCount );
 
-        dListIterator_increment( pathIterator );
+        size_t pairNum;
+        for( pairNum = 0; pairNum < edgeList->edgePairCount; pairNum++ )
+            unionFind_unite( *components, edgeList->edgePairs[ 2 * pairNum ], edgeList->edgePairs[ 2 * pairNum + 1 ] );
     }
 
-    // Assume that we found a path.
-    EulerianCycleResult result = { true, path };
+    edgeList_destroy( edgeList );
 
-    // Now we have to check if there're no more edges inside the graph.
-    // This is important because it could be a disconnected graph
-    // which we haven't been able to recognize yet.
-    if( graph_hasEdges( graph ))
-    {
-        result.exists = false;
-        result.eulerianCycle = NULL;
-    }
-
-    return result;
+    return graph;
 }
 
 
-Path *extractSubCircle( Graph *graph, int startVertexNum )
+void saveBinaryGraph( char *filename, char *binaryFilename, int threadCount )
 {
-    Path *subCircle = path_new();
-
-    // We append the first vertex to the sub-circle.
-    path_append( subCircle, startVertexNum );
-
-    // Setting start values.
-    int currVertexNum = startVertexNum;
-    Vertex *currVertex = graph_getVertex( graph, startVertexNum );
-
-    // We only stop if we're back on the start vertex and there are no more edges left.
-    while( !( currVertexNum == startVertexNum && vertex_getDegree( currVertex ) == 0 ))
+    EdgeListError error;
+    EdgeList *edgeList = edgeList_load( filename, threadCount, &error );
+    if( edgeList == NULL )
     {
-        // Due to the condition that we had a graph whos vertices have an even degree, we can assert
-        // that the current vertex has at least one edge leading us to the next vertex.
-        assert( vertex_getDegree( currVertex ) > 0 );
-
-        DList *edges = vertex_getEdges( currVertex );
-        Edge *firstEdge = (Edge *) dList_get( edges, 0 );
-
-        // Simply select the first edge to get to the next vertex.
-        int nextVertexNum = edge_getToVertexNum( firstEdge );
+        if( error.line > 0 )
+            fprintf( stderr, "Ungueltiges Eingabeformat (Zeile %d, Spalte %d: %s)\n", error.line, error.column, error.message );
+        else
+            fprintf( stderr, "Konnte %s nicht lesen\n", filename );
+        return;
+    }
 
-        // Append the next vertex to the sub-circle.
-        path_append( subCircle, nextVertexNum );
+    // The binary format counts half-edges in 32 bits.
+    if( edgeList->edgePairCount > INT_MAX / 2 )
+    {
+        fprintf( stderr, "Ungueltiges Eingabeformat\n" );
+        edgeList_destroy( edgeList );
+        return;
+    }
 
-        // And now we remove the edges between the vertices so we won't take it again.
-        graph_removeEdgePair( graph, currVertexNum, nextVertexNum );
+    CsrGraph *csrGraph = csrGraph_newFromEdgePairs( edgeList->vertexCount, edgeList->edgePairs, (int) edgeList->edgePairCount );
+    edgeList_destroy( edgeList );
 
-        // Finally we update the current vertex.
-        currVertexNum = nextVertexNum;
-        currVertex = graph_getVertex( graph, nextVertexNum );
-    }
+    if( !csrGraph_save( csrGraph, binaryFilename ))
+        fprintf( stderr, "Konnte %s nicht schreiben\n", binaryFilename );
 
-    return subCircle;
+    csrGraph_destroy( csrGraph );
+    return;
 }
 
 
-void printEulerianCycle( Path *eulerianCycle )
+void printEulerianCycle( OutputWriter *output, Path *eulerianCycle )
 {
-    DList *pathElements = path_getElements( eulerianCycle );
-    DListIterator *pathIterator = dListIterator_getIteratorFromList( pathElements );
+    PathIterator pathIterator;
 
-    dList_foreach( pathIterator, pathElements )
+    for( pathIterator_toFirst( &pathIterator, eulerianCycle );
+         !pathIterator_isAtEnd( &pathIterator, eulerianCycle );
+         pathIterator_increment( &pathIterator, eulerianCycle ))
     {
-        PathElement *currElement = (PathElement *) dListIterator_get( pathIterator );
+        PathElement *currElement = pathIterator_get( &pathIterator, eulerianCycle );
 
-        printf( "%d ", currElement->vertexNum );
+        outputWriter_writeInt( output, currElement->vertexNum );
+        outputWriter_writeChar( output, ' ' );
     }
 
     return;
 }
 
 
-void printEulerianPath( Path *eulerianCylce, int addedVertexNum )
+void printEulerianCircuit( OutputWriter *output, EulerianCircuit circuit )
 {
-    // Since we got an eulerian cyclce the first and the last elements are equal.
-    // However this cannot occur on a graph which has 2 vertices with uneven degree.
-    // So we will simply remove the last element of the path.
-    DList *pathElements = path_getElements( eulerianCylce );
-    DListIterator *pathIterator = dListIterator_getIteratorFromList( pathElements );
-    dListIterator_toLast( pathIterator, pathElements );
-    dListIterator_destroy( pathIterator, pathElements );
-
-    // We have to find the added vertex element in the path.
-    PathElement searchElement = { addedVertexNum };
-    Comparator *comparator = comparator_new( &searchElement, (CompareFunction) pathElement_equals );
-
-    dListIterator_toFirst( pathIterator, pathElements );
-    PathElement *addedVertexElement = (PathElement *) dListIterator_search( &pathIterator, pathElements, comparator );
-    assert( addedVertexElement != NULL );
-
-    // Now we are going to print out the path.
-    while( true )
+    size_t position;
+    for( position = 0; position < circuit.length; position++ )
     {
-        dListIterator_increment( pathIterator );
-
-        // If we're at the end of the path, we jump back to the beginning.
-        if( dListIterator_isAtEnd( pathIterator, pathElements ))
-            dListIterator_toFirst( pathIterator, pathElements );
-
-        PathElement *currElement = (PathElement *) dListIterator_get( pathIterator );
-
-        // Stop if find the added vertex which we do NOT want to print obviously.
-        if( currElement == addedVertexElement )
-            break;
-
-        printf( "%d ", pathElement_getVertexNum( currElement ));
+        outputWriter_writeInt( output, circuit.vertices[ position ] );
+        outputWriter_writeChar( output, ' ' );
     }
 
-    // Clean up.
-    comparator_destroy( comparator );
-
     return;
 }
+
@@ -0,0 +1,117 @@
+#include "outputwriter.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "string.h"
+#include "unistd.h"
+
+
+OutputWriter *outputWriter_new( int fd )
+{
+    OutputWriter *writer = (OutputWriter *) malloc( sizeof( OutputWriter ));
+    assert( writer != NULL );
+
+    writer->fd = fd;
+    writer->ownsFd = false;
+    writer->failed = false;
+    writer->size = 0;
+    writer->buffer = (char *) malloc( OUTPUTWRITER_BUFFER_SIZE );
+    assert( writer->buffer != NULL );
+
+    return writer;
+}
+
+
+OutputWriter *outputWriter_open( const char *filename )
+{
+    int fd = open( filename, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( fd < 0 )
+        return NULL;
+
+    OutputWriter *writer = outputWriter_new( fd );
+    writer->ownsFd = true;
+
+    return writer;
+}
+
+
+bool outputWriter_destroy( OutputWriter *writer )
+{
+    bool written = outputWriter_flush( writer );
+
+    if( writer->ownsFd && close( writer->fd ) != 0 )
+        written = false;
+
+    free( writer->buffer );
+    free( writer );
+
+    return written;
+}
+
+
+bool outputWriter_flush( OutputWriter *writer )
+{
+    // write() may take only a part of the buffer, so we go on until everything is gone. A write() that makes no
+    // progress counts as a failure, otherwise we would spin forever.
+    size_t offset = 0;
+    while( !writer->failed && offset < writer->size )
+    {
+        ssize_t bytesWritten = write( writer->fd, writer->buffer + offset, writer->size - offset );
+        if( bytesWritten > 0 )
+            offset += (size_t) bytesWritten;
+        else if( bytesWritten == 0 || errno != EINTR )
+            writer->failed = true;
+    }
+
+    writer->size = 0;
+    return !writer->failed;
+}
+
+
+void outputWriter_writeInt( OutputWriter *writer, int value )
+{
+    // An int has at most ten digits and a sign.
+    if( OUTPUTWRITER_BUFFER_SIZE - writer->size < 11 )
+        outputWriter_flush( writer );
+
+    // We compute with the magnitude as unsigned number, so even INT_MIN can be negated.
+    unsigned int magnitude = (unsigned int) value;
+    if( value < 0 )
+    {
+        writer->buffer[ writer->size++ ] = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    // The digits come out backwards, so we collect them first.
+    char digits[ 10 ];
+    int digitCount = 0;
+    do
+    {
+        digits[ digitCount++ ] = (char) ( '0' + magnitude % 10 );
+        magnitude /= 10;
+    }
+    while( magnitude > 0 );
+
+    while( digitCount > 0 )
+        writer->buffer[ writer->size++ ] = digits[ --digitCount ];
+
+    return;
+}
+
+
+void outputWriter_writeChar( OutputWriter *writer, char character )
+{
+    if( writer->size == OUTPUTWRITER_BUFFER_SIZE )
+        outputWriter_flush( writer );
+
+    writer->buffer[ writer->size++ ] = character;
+    return;
+}
+
+
+void outputWriter_writeString( OutputWriter *writer, const char *string )
+{
+    while( *string != '\0' )
+        outputWriter_writeChar( writer, *string++ );
+
+    return;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file outputwriter.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A buffered writer for long lists of numbers.
+ */
+
+
+#ifndef OUTPUTWRITER
+#define OUTPUTWRITER
+
+
+#include "basic.h"
+
+
+/**
+ * @brief The size of the buffer of an output writer.
+ */
+#define OUTPUTWRITER_BUFFER_SIZE    ( 1 << 20 )
+
+
+/**
+ * @brief Collects text in a large buffer and hands it to write(2) whenever the buffer is full.
+ *
+ * Numbers are formatted by hand, so there's no format string to parse and no stdio lock to take per number.
+ * Anything printed through stdio on the same file descriptor must be flushed before using the writer.
+ */
+typedef struct
+{
+    int         fd;             /**< The file descriptor which is written to. */
+    bool        ownsFd;         /**< true, if the file descriptor is closed by 'outputWriter_destroy()'. */
+    bool        failed;         /**< true, if a write has failed. Everything after that is dropped. */
+    size_t      size;           /**< The number of bytes in the buffer. */
+    char *      buffer;         /**< OUTPUTWRITER_BUFFER_SIZE bytes. */
+} OutputWriter;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new writer for a file descriptor which is already open.
+ * @param fd
+ * @return The pointer to the new writer.
+ */
+OutputWriter *outputWriter_new( int fd );
+
+
+/**
+ * @brief Creates or truncates a file and allocates a new writer for it.
+ * @param filename
+ * @return The pointer to the new writer or NULL if the file couldn't be opened.
+ */
+OutputWriter *outputWriter_open( const char *filename );
+
+
+/**
+ * @brief Flushes the buffer, closes the file if it was opened by the writer and frees the writer.
+ * @param writer
+ * @return true, if everything has been written.
+ */
+bool outputWriter_destroy( OutputWriter *writer );
+
+
+/**
+ * @brief Writes the buffer to the file.
+ * @param writer
+ * @return true, if everything has been written so far.
+ */
+bool outputWriter_flush( OutputWriter *writer );
+
+
+/**
+ * @brief Appends a number in decimal, just like printf( "%d" ).
+ * @param writer
+ * @param value
+ */
+void outputWriter_writeInt( OutputWriter *writer, int value );
+
+
+/**
+ * @brief Appends a single character.
+ * @param writer
+ * @param character
+ */
+void outputWriter_writeChar( OutputWriter *writer, char character );
+
+
+/**
+ * @brief Appends a string without its terminating zero.
+ * @param writer
+ * @param string
+ */
+void outputWriter_writeString( OutputWriter *writer, const char *string );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // OUTPUTWRITER
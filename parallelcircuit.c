@@ -0,0 +1,719 @@
+#include "parallelcircuit.h"
+#include "string.h"
+#include "limits.h"
+#include "pthread.h"
+
+
+/**
+ * @brief Every thread gets about this many pieces of the circuit, so threads with short pieces take more of them.
+ */
+#define PARALLELCIRCUIT_PIECES_PER_THREAD       256
+
+
+/**
+ * @brief The pieces are never shorter than this on average, so finding their place stays cheap.
+ */
+#define PARALLELCIRCUIT_MIN_PIECE_LENGTH        256
+
+
+/**
+ * @brief The number of pieces a thread takes at once.
+ */
+#define PARALLELCIRCUIT_PIECE_CHUNK             16
+
+
+/**
+ * @brief The state which the threads share.
+ *
+ * Every edge pair consists of two half-edges, one at each end. The half-edges of vertex v are numbered
+ * from offsets[v] to offsets[v + 1] - 1 in the order of its edge array. With a virtual edge pair,
+ * each of the two vertices with uneven degree has one more half-edge at the end.
+ * Since all degrees are even then, half-edge h is initially paired with h ^ 1.
+ */
+typedef struct
+{
+    Graph *         graph;
+    int             threadCount;        /**< The number of threads, including the calling one. */
+    int             vertexCount;        /**< The number of vertices. */
+    int             virtualVertexNum1;  /**< The vertex where the virtual edge pair starts, or VERTEX_UNDEFINED. */
+    int             virtualVertexNum2;  /**< The vertex where the virtual edge pair ends, or VERTEX_UNDEFINED. */
+    int *           offsets;            /**< vertexCount + 1 entries: the first half-edge of each vertex and the total count. */
+    int             halfEdgeCount;      /**< The number of half-edges including the virtual ones. */
+    int *           rangeStarts;        /**< threadCount + 1 entries: the first vertex of each thread, balanced by half-edges. */
+    long long *     rangeDegrees;       /**< The sum of the degrees of the vertices of each thread while counting. */
+    int *           partners;           /**< The half-edge which a walk leaves along after arriving on a half-edge. */
+    int *           trails;             /**< The union-find of the initial trails, later the vertex each half-edge goes to. */
+    int *           merges;             /**< The union-find of the merged trails, later the half-edge which follows each one. */
+    uint64_t *      cutBits;            /**< One bit per half-edge: true, if a piece starts at its edge pair. */
+    int *           cuts;               /**< The half-edges where pieces start, in ascending order. */
+    int             cutCount;           /**< The number of pieces. */
+    int             cutStride;          /**< Every cutStride-th half-edge cuts the trail. */
+    int *           pieceEnds;          /**< The cut where each piece ends, which is where the next piece starts. */
+    int *           pieceLengths;       /**< The number of half-edges of each piece. */
+    long long *     piecePositions;     /**< The position of each piece in the circuit, or -1 if it runs the other way round. */
+    int             nextPiece;          /**< The first piece which no thread has taken yet. */
+    int *           vertices;           /**< The result. */
+    size_t          firstPosition;      /**< Where the vertex of the first half-edge goes: 1 for a cycle, 0 for a path. */
+} ParallelCircuit;
+
+
+/**
+ * @brief A step which every thread executes on its share.
+ */
+typedef void (*Phase)( ParallelCircuit *circuit, int threadNum );
+
+
+/**
+ * @brief The argument of a thread executing a phase.
+ */
+typedef struct
+{
+    ParallelCircuit *   circuit;
+    Phase               phase;
+    int                 threadNum;
+} PhaseTask;
+
+
+static void *phaseTask_run( void *argument )
+{
+    PhaseTask *task = (PhaseTask *) argument;
+    task->phase( task->circuit, task->threadNum );
+    return NULL;
+}
+
+
+/**
+ * @brief Executes a phase on all threads and waits until all of them are done.
+ * The calling thread takes the first share itself.
+ */
+static void runPhase( ParallelCircuit *circuit, Phase phase )
+{
+    int threadCount = circuit->threadCount;
+    pthread_t *threads = (pthread_t *) malloc( threadCount * sizeof( pthread_t ));
+    PhaseTask *tasks = (PhaseTask *) malloc( threadCount * sizeof( PhaseTask ));
+    assert( threads != NULL && tasks != NULL );
+
+    int threadNum;
+    for( threadNum = 0; threadNum < threadCount; threadNum++ )
+    {
+        tasks[ threadNum ].circuit = circuit;
+        tasks[ threadNum ].phase = phase;
+        tasks[ threadNum ].threadNum = threadNum;
+    }
+
+    for( threadNum = 1; threadNum < threadCount; threadNum++ )
+        pthread_create( &threads[ threadNum ], NULL, phaseTask_run, &tasks[ threadNum ] );
+
+    phase( circuit, 0 );
+
+    for( threadNum = 1; threadNum < threadCount; threadNum++ )
+        pthread_join( threads[ threadNum ], NULL );
+
+    free( tasks );
+    free( threads );
+    return;
+}
+
+
+/**
+ * @brief Finds the root of a node in a union-find which other threads change at the same time.
+ * Every node on the way is linked to its grandparent, which keeps the trees flat.
+ */
+static int findRoot( int *parents, int node )
+{
+    while( true )
+    {
+        int parent = __atomic_load_n( &parents[ node ], __ATOMIC_RELAXED );
+        if( parent == node )
+            return node;
+
+        int grandParent = __atomic_load_n( &parents[ parent ], __ATOMIC_RELAXED );
+        if( grandParent != parent )
+            __atomic_compare_exchange_n( &parents[ node ], &parent, grandParent, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+
+        node = grandParent;
+    }
+}
+
+
+/**
+ * @brief Unites the sets of two nodes in a union-find which other threads change at the same time.
+ * A root is always linked below a root with a smaller number, so no thread can ever close a loop.
+ * @return true, if the nodes were in different sets. Exactly one of all threads gets true for each link.
+ */
+static bool uniteRoots( int *parents, int node1, int node2 )
+{
+    while( true )
+    {
+        node1 = findRoot( parents, node1 );
+        node2 = findRoot( parents, node2 );
+        if( node1 == node2 )
+            return false;
+
+        if( node1 < node2 )
+        {
+            int swap = node1;
+            node1 = node2;
+            node2 = swap;
+        }
+
+        // Fails if another thread has linked node1 in the meantime.
+        int expected = node1;
+        if( __atomic_compare_exchange_n( &parents[ node1 ], &expected, node2, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ))
+            return true;
+    }
+}
+
+
+/**
+ * @return The number of half-edges of a vertex, including a virtual one.
+ */
+static int getHalfEdgeCount( ParallelCircuit *circuit, int vertexNum )
+{
+    int count = graph_getDegree( circuit->graph, vertexNum );
+    if( vertexNum == circuit->virtualVertexNum1 || vertexNum == circuit->virtualVertexNum2 )
+        count++;
+
+    return count;
+}
+
+
+/**
+ * @return The half-edge at the other end of the edge pair of a half-edge of a vertex with the given edge array and degree.
+ */
+static int getTwin( ParallelCircuit *circuit, int vertexNum, Edge *edges, int degree, int edgeIndex )
+{
+    if( edgeIndex == degree )
+    {
+        // The virtual half-edge is the last one of both vertices.
+        int otherVertexNum = ( vertexNum == circuit->virtualVertexNum1 ) ? circuit->virtualVertexNum2 : circuit->virtualVertexNum1;
+        return circuit->offsets[ otherVertexNum + 1 ] - 1;
+    }
+
+    Edge *edge = &edges[ edgeIndex ];
+    return circuit->offsets[ edge_getToVertexNum( edge ) ] + edge_getCorrespondingEdgeIndex( edge );
+}
+
+
+/**
+ * @return The vertex which a half-edge of a vertex with the given edge array and degree goes to.
+ */
+static int getTarget( ParallelCircuit *circuit, int vertexNum, Edge *edges, int degree, int edgeIndex )
+{
+    if( edgeIndex == degree )
+        return ( vertexNum == circuit->virtualVertexNum1 ) ? circuit->virtualVertexNum2 : circuit->virtualVertexNum1;
+
+    return edge_getToVertexNum( &edges[ edgeIndex ] );
+}
+
+
+/**
+ * @brief The share of a thread when splitting count items evenly.
+ */
+static void getEvenRange( int count, int threadCount, int threadNum, int *start, int *end )
+{
+    *start = (int) ( (long long) count * threadNum / threadCount );
+    *end = (int) ( (long long) count * ( threadNum + 1 ) / threadCount );
+    return;
+}
+
+
+/**
+ * @brief Sums up the half-edges of an even share of the vertices.
+ */
+static void phase_countHalfEdges( ParallelCircuit *circuit, int threadNum )
+{
+    int start, end;
+    getEvenRange( circuit->vertexCount, circuit->threadCount, threadNum, &start, &end );
+
+    long long sum = 0;
+    int vertexNum;
+    for( vertexNum = start; vertexNum < end; vertexNum++ )
+        sum += getHalfEdgeCount( circuit, vertexNum );
+
+    circuit->rangeDegrees[ threadNum ] = sum;
+    return;
+}
+
+
+/**
+ * @brief Writes the offsets of an even share of the vertices. The sums of the shares before have been added up.
+ */
+static void phase_writeOffsets( ParallelCircuit *circuit, int threadNum )
+{
+    int start, end;
+    getEvenRange( circuit->vertexCount, circuit->threadCount, threadNum, &start, &end );
+
+    int offset = (int) circuit->rangeDegrees[ threadNum ];
+    int vertexNum;
+    for( vertexNum = start; vertexNum < end; vertexNum++ )
+    {
+        circuit->offsets[ vertexNum ] = offset;
+        offset += getHalfEdgeCount( circuit, vertexNum );
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Pairs every half-edge with its neighbor and makes every half-edge a set of its own.
+ */
+static void phase_initialize( ParallelCircuit *circuit, int threadNum )
+{
+    int start, end;
+    getEvenRange( circuit->halfEdgeCount, circuit->threadCount, threadNum, &start, &end );
+
+    int halfEdge;
+    for( halfEdge = start; halfEdge < end; halfEdge++ )
+    {
+        circuit->partners[ halfEdge ] = halfEdge ^ 1;
+        circuit->trails[ halfEdge ] = halfEdge;
+        circuit->merges[ halfEdge ] = halfEdge;
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Unites every half-edge with its partner and with its twin, so the sets become the initial trails.
+ */
+static void phase_findTrails( ParallelCircuit *circuit, int threadNum )
+{
+    int vertexNum;
+    for( vertexNum = circuit->rangeStarts[ threadNum ]; vertexNum < circuit->rangeStarts[ threadNum + 1 ]; vertexNum++ )
+    {
+        Edge *edges = graph_getEdges( circuit->graph, vertexNum );
+        int degree = graph_getDegree( circuit->graph, vertexNum );
+        int offset = circuit->offsets[ vertexNum ];
+        int count = circuit->offsets[ vertexNum + 1 ] - offset;
+
+        int edgeIndex;
+        for( edgeIndex = 0; edgeIndex < count; edgeIndex++ )
+        {
+            int halfEdge = offset + edgeIndex;
+            if( !( edgeIndex & 1 ))
+                uniteRoots( circuit->trails, halfEdge, halfEdge + 1 );
+
+            // Each edge pair is united from one side only.
+            int twin = getTwin( circuit, vertexNum, edges, degree, edgeIndex );
+            if( halfEdge < twin )
+                uniteRoots( circuit->trails, halfEdge, twin );
+        }
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Replaces the parent of every half-edge with its root, so the trail of a half-edge can be read directly.
+ */
+static void phase_labelTrails( ParallelCircuit *circuit, int threadNum )
+{
+    int start, end;
+    getEvenRange( circuit->halfEdgeCount, circuit->threadCount, threadNum, &start, &end );
+
+    int halfEdge;
+    for( halfEdge = start; halfEdge < end; halfEdge++ )
+        __atomic_store_n( &circuit->trails[ halfEdge ], findRoot( circuit->trails, halfEdge ), __ATOMIC_RELAXED );
+
+    return;
+}
+
+
+/**
+ * @brief Merges all trails which meet at a vertex by swapping partners.
+ *
+ * The first pair of the vertex is compared with each other pair. If they belong to different trails,
+ * cutting both trails at the vertex and connecting the ends the other way round gives one trail.
+ * The union-find of merged trails decides which thread merges two trails, so no two trails are merged twice.
+ */
+static void phase_mergeTrails( ParallelCircuit *circuit, int threadNum )
+{
+    int *partners = circuit->partners;
+
+    int vertexNum;
+    for( vertexNum = circuit->rangeStarts[ threadNum ]; vertexNum < circuit->rangeStarts[ threadNum + 1 ]; vertexNum++ )
+    {
+        int first = circuit->offsets[ vertexNum ];
+        int end = circuit->offsets[ vertexNum + 1 ];
+
+        int pair;
+        for( pair = first + 2; pair < end; pair += 2 )
+        {
+            if( !uniteRoots( circuit->merges, circuit->trails[ first ], circuit->trails[ pair ] ))
+                continue;
+
+            int firstPartner = partners[ first ];
+            partners[ first ] = pair;
+            partners[ pair ] = first;
+            partners[ firstPartner ] = pair + 1;
+            partners[ pair + 1 ] = firstPartner;
+        }
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Stores where each half-edge goes and which half-edge follows it, and marks the edge pairs where pieces start.
+ * The union-find arrays aren't needed anymore, so they're reused for that.
+ */
+static void phase_linkHalfEdges( ParallelCircuit *circuit, int threadNum )
+{
+    int *targets = circuit->trails;
+    int *successors = circuit->merges;
+
+    int vertexNum;
+    for( vertexNum = circuit->rangeStarts[ threadNum ]; vertexNum < circuit->rangeStarts[ threadNum + 1 ]; vertexNum++ )
+    {
+        Edge *edges = graph_getEdges( circuit->graph, vertexNum );
+        int degree = graph_getDegree( circuit->graph, vertexNum );
+        int offset = circuit->offsets[ vertexNum ];
+        int count = circuit->offsets[ vertexNum + 1 ] - offset;
+
+        int edgeIndex;
+        for( edgeIndex = 0; edgeIndex < count; edgeIndex++ )
+        {
+            int halfEdge = offset + edgeIndex;
+            int twin = getTwin( circuit, vertexNum, edges, degree, edgeIndex );
+
+            // A walk along the half-edge arrives on its twin and leaves along the partner of the twin.
+            targets[ halfEdge ] = getTarget( circuit, vertexNum, edges, degree, edgeIndex );
+            successors[ halfEdge ] = circuit->partners[ twin ];
+
+            // Both halves are marked, since we don't know yet which direction the circuit takes.
+            if( halfEdge % circuit->cutStride == 0 )
+            {
+                __atomic_fetch_or( &circuit->cutBits[ halfEdge / 64 ], (uint64_t) 1 << ( halfEdge % 64 ), __ATOMIC_RELAXED );
+                __atomic_fetch_or( &circuit->cutBits[ twin / 64 ], (uint64_t) 1 << ( twin % 64 ), __ATOMIC_RELAXED );
+            }
+        }
+    }
+
+    return;
+}
+
+
+static bool isCut( ParallelCircuit *circuit, int halfEdge )
+{
+    return ( circuit->cutBits[ halfEdge / 64 ] >> ( halfEdge % 64 )) & 1;
+}
+
+
+/**
+ * @return The number of the piece which starts at a marked half-edge.
+ */
+static int findPiece( ParallelCircuit *circuit, int halfEdge )
+{
+    int low = 0;
+    int high = circuit->cutCount - 1;
+    while( low < high )
+    {
+        int middle = low + ( high - low ) / 2;
+        if( circuit->cuts[ middle ] < halfEdge )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+
+/**
+ * @brief Takes the next few pieces which no thread has taken yet.
+ * @return false, if there're no pieces left.
+ */
+static bool takePieces( ParallelCircuit *circuit, int *start, int *end )
+{
+    *start = __atomic_fetch_add( &circuit->nextPiece, PARALLELCIRCUIT_PIECE_CHUNK, __ATOMIC_RELAXED );
+    if( *start >= circuit->cutCount )
+        return false;
+
+    *end = ( *start + PARALLELCIRCUIT_PIECE_CHUNK < circuit->cutCount ) ? *start + PARALLELCIRCUIT_PIECE_CHUNK : circuit->cutCount;
+    return true;
+}
+
+
+/**
+ * @brief Follows each piece until the next marked half-edge and stores its length and end.
+ * Both directions of the circuit are walked, since half of the pieces run the other way round.
+ */
+static void phase_measurePieces( ParallelCircuit *circuit, int threadNum )
+{
+    // The threads take chunks of pieces as they go instead of a fixed range, so the thread number isn't needed.
+    (void) threadNum;
+
+    int *successors = circuit->merges;
+
+    int start, end;
+    while( takePieces( circuit, &start, &end ))
+    {
+        int pieceNum;
+        for( pieceNum = start; pieceNum < end; pieceNum++ )
+        {
+            int halfEdge = successors[ circuit->cuts[ pieceNum ]];
+            int length = 1;
+            while( !isCut( circuit, halfEdge ))
+            {
+                halfEdge = successors[ halfEdge ];
+                length++;
+            }
+
+            circuit->pieceEnds[ pieceNum ] = findPiece( circuit, halfEdge );
+            circuit->pieceLengths[ pieceNum ] = length;
+        }
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Writes the vertices of the pieces which belong to the circuit to their positions.
+ */
+static void phase_writePieces( ParallelCircuit *circuit, int threadNum )
+{
+    // The threads take chunks of pieces as they go instead of a fixed range, so the thread number isn't needed.
+    (void) threadNum;
+
+    int *targets = circuit->trails;
+    int *successors = circuit->merges;
+
+    int start, end;
+    while( takePieces( circuit, &start, &end ))
+    {
+        int pieceNum;
+        for( pieceNum = start; pieceNum < end; pieceNum++ )
+        {
+            if( circuit->piecePositions[ pieceNum ] < 0 )
+                continue;
+
+            int *vertices = circuit->vertices + circuit->firstPosition + circuit->piecePositions[ pieceNum ];
+            int halfEdge = circuit->cuts[ pieceNum ];
+            int position;
+            for( position = 0; position < circuit->pieceLengths[ pieceNum ]; position++ )
+            {
+                vertices[ position ] = targets[ halfEdge ];
+                halfEdge = successors[ halfEdge ];
+            }
+        }
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Splits the vertices among the threads so that each thread gets about the same number of half-edges.
+ */
+static void balanceRanges( ParallelCircuit *circuit )
+{
+    int threadNum;
+    for( threadNum = 0; threadNum < circuit->threadCount; threadNum++ )
+    {
+        // The first vertex whose half-edges start at or behind the share of the thread.
+        long long share = (long long) circuit->halfEdgeCount * threadNum / circuit->threadCount;
+        int low = 0;
+        int high = circuit->vertexCount;
+        while( low < high )
+        {
+            int middle = low + ( high - low ) / 2;
+            if( circuit->offsets[ middle ] < share )
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        circuit->rangeStarts[ threadNum ] = low;
+    }
+
+    circuit->rangeStarts[ circuit->threadCount ] = circuit->vertexCount;
+    return;
+}
+
+
+/**
+ * @brief Collects the marked half-edges in ascending order.
+ */
+static void collectCuts( ParallelCircuit *circuit )
+{
+    size_t wordCount = ( (size_t) circuit->halfEdgeCount + 63 ) / 64;
+    size_t wordNum;
+
+    circuit->cutCount = 0;
+    for( wordNum = 0; wordNum < wordCount; wordNum++ )
+        circuit->cutCount += __builtin_popcountll( circuit->cutBits[ wordNum ] );
+
+    circuit->cuts = (int *) malloc( circuit->cutCount * sizeof( int ));
+    circuit->pieceEnds = (int *) malloc( circuit->cutCount * sizeof( int ));
+    circuit->pieceLengths = (int *) malloc( circuit->cutCount * sizeof( int ));
+    circuit->piecePositions = (long long *) malloc( circuit->cutCount * sizeof( long long ));
+    assert( circuit->cuts != NULL && circuit->pieceEnds != NULL && circuit->pieceLengths != NULL && circuit->piecePositions != NULL );
+
+    int cutNum = 0;
+    for( wordNum = 0; wordNum < wordCount; wordNum++ )
+    {
+        uint64_t word = circuit->cutBits[ wordNum ];
+        while( word != 0 )
+        {
+            circuit->cuts[ cutNum++ ] = (int) ( wordNum * 64 ) + __builtin_ctzll( word );
+            word &= word - 1;
+        }
+    }
+
+    return;
+}
+
+
+bool traceEulerianCircuitParallel( Graph *graph, GraphInformation graphInfo, CircuitWorkspace *workspace,
+                                   int *vertices, size_t length, int threadCount )
+{
+    // Each thread needs enough edges to be worth starting, and the half-edges must be countable with ints.
+    size_t edgePairCount = length - 1;
+    if( (size_t) threadCount > edgePairCount / PARALLELCIRCUIT_MIN_EDGES_PER_THREAD )
+        threadCount = (int) ( edgePairCount / PARALLELCIRCUIT_MIN_EDGES_PER_THREAD );
+
+    if( threadCount < 2 || edgePairCount >= INT_MAX / 2 - 1 )
+        return traceEulerianCircuit( graph, graphInfo, workspace, vertices, length );
+
+    ParallelCircuit circuit;
+    memset( &circuit, 0, sizeof( circuit ));
+    circuit.graph = graph;
+    circuit.threadCount = threadCount;
+    circuit.vertexCount = graph_getVertexCount( graph );
+    circuit.virtualVertexNum1 = VERTEX_UNDEFINED;
+    circuit.virtualVertexNum2 = VERTEX_UNDEFINED;
+    circuit.vertices = vertices;
+
+    // A path gets a virtual edge pair from its end back to its start, so it's a cycle as well.
+    int startVertexNum = getStartVertexNum( graphInfo );
+    if( graphInfo.graphType == GRAPH_TYPE_TWO_VERTICES_WITH_UNEVEN_DEGREE )
+    {
+        circuit.virtualVertexNum1 = graphInfo.startOrEndVertexNum2;
+        circuit.virtualVertexNum2 = graphInfo.startOrEndVertexNum1;
+    }
+
+    circuit.offsets = (int *) malloc(( circuit.vertexCount + 1 ) * sizeof( int ));
+    circuit.rangeStarts = (int *) malloc(( threadCount + 1 ) * sizeof( int ));
+    circuit.rangeDegrees = (long long *) malloc( threadCount * sizeof( long long ));
+    assert( circuit.offsets != NULL && circuit.rangeStarts != NULL && circuit.rangeDegrees != NULL );
+
+    runPhase( &circuit, phase_countHalfEdges );
+
+    long long halfEdgeCount = 0;
+    int threadNum;
+    for( threadNum = 0; threadNum < threadCount; threadNum++ )
+    {
+        long long count = circuit.rangeDegrees[ threadNum ];
+        circuit.rangeDegrees[ threadNum ] = halfEdgeCount;
+        halfEdgeCount += count;
+    }
+
+    circuit.halfEdgeCount = (int) halfEdgeCount;
+    circuit.offsets[ circuit.vertexCount ] = circuit.halfEdgeCount;
+    runPhase( &circuit, phase_writeOffsets );
+    balanceRanges( &circuit );
+
+    circuit.partners = (int *) malloc( circuit.halfEdgeCount * sizeof( int ));
+    circuit.trails = (int *) malloc( circuit.halfEdgeCount * sizeof( int ));
+    circuit.merges = (int *) malloc( circuit.halfEdgeCount * sizeof( int ));
+    circuit.cutBits = (uint64_t *) calloc(( (size_t) circuit.halfEdgeCount + 63 ) / 64, sizeof( uint64_t ));
+    assert( circuit.partners != NULL && circuit.trails != NULL && circuit.merges != NULL && circuit.cutBits != NULL );
+
+    runPhase( &circuit, phase_initialize );
+    runPhase( &circuit, phase_findTrails );
+    runPhase( &circuit, phase_labelTrails );
+    runPhase( &circuit, phase_mergeTrails );
+
+    circuit.cutStride = circuit.halfEdgeCount / ( threadCount * PARALLELCIRCUIT_PIECES_PER_THREAD );
+    if( circuit.cutStride < PARALLELCIRCUIT_MIN_PIECE_LENGTH )
+        circuit.cutStride = PARALLELCIRCUIT_MIN_PIECE_LENGTH;
+
+    runPhase( &circuit, phase_linkHalfEdges );
+
+    // The circuit starts at the start vertex. For a path, that's where the virtual half-edge arrives,
+    // which itself isn't written.
+    int firstHalfEdge;
+    if( circuit.virtualVertexNum1 != VERTEX_UNDEFINED )
+    {
+        firstHalfEdge = circuit.offsets[ circuit.virtualVertexNum1 + 1 ] - 1;
+        circuit.firstPosition = 0;
+    }
+    else
+    {
+        firstHalfEdge = circuit.offsets[ startVertexNum ];
+        circuit.firstPosition = 1;
+        vertices[ 0 ] = startVertexNum;
+    }
+
+    circuit.cutBits[ firstHalfEdge / 64 ] |= (uint64_t) 1 << ( firstHalfEdge % 64 );
+
+    collectCuts( &circuit );
+
+    circuit.nextPiece = 0;
+    runPhase( &circuit, phase_measurePieces );
+
+    // Chain the pieces from the first half-edge on. The pieces of the other direction and of other components are left out.
+    int pieceNum;
+    for( pieceNum = 0; pieceNum < circuit.cutCount; pieceNum++ )
+        circuit.piecePositions[ pieceNum ] = -1;
+
+    long long position = 0;
+    int firstPiece = findPiece( &circuit, firstHalfEdge );
+    pieceNum = firstPiece;
+    do
+    {
+        circuit.piecePositions[ pieceNum ] = position;
+        position += circuit.pieceLengths[ pieceNum ];
+        pieceNum = circuit.pieceEnds[ pieceNum ];
+    }
+    while( pieceNum != firstPiece );
+
+    // If the circuit misses edges, the graph is disconnected.
+    bool complete = ( position == (long long) ( circuit.halfEdgeCount / 2 ));
+    if( complete )
+    {
+        circuit.nextPiece = 0;
+        runPhase( &circuit, phase_writePieces );
+    }
+
+    free( circuit.piecePositions );
+    free( circuit.pieceLengths );
+    free( circuit.pieceEnds );
+    free( circuit.cuts );
+    free( circuit.cutBits );
+    free( circuit.merges );
+    free( circuit.trails );
+    free( circuit.partners );
+    free( circuit.rangeDegrees );
+    free( circuit.rangeStarts );
+    free( circuit.offsets );
+
+    return complete;
+}
+
+
+EulerianCircuit findEulerianCircuitParallel( Graph *graph, GraphInformation graphInfo, int threadCount )
+{
+    EulerianCircuit circuit = { true, NULL, getEulerianCircuitLength( graph ) };
+    circuit.vertices = (int *) malloc( circuit.length * sizeof( int ));
+    assert( circuit.vertices != NULL );
+
+    CircuitWorkspace *workspace = circuitWorkspace_new();
+    circuit.exists = traceEulerianCircuitParallel( graph, graphInfo, workspace, circuit.vertices, circuit.length, threadCount );
+    circuitWorkspace_destroy( workspace );
+
+    if( !circuit.exists )
+    {
+        free( circuit.vertices );
+        circuit.vertices = NULL;
+        circuit.length = 0;
+    }
+
+    return circuit;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file parallelcircuit.h
+ * @author Philipp Badenhoop
+ * @date 17 Oct 2026
+ * @brief Finds an eulerian cycle or path with many threads.
+ */
+
+
+#ifndef PARALLELCIRCUIT
+#define PARALLELCIRCUIT
+
+
+#include "basic.h"
+#include "graph.h"
+#include "hierholzer.h"
+
+
+/**
+ * @brief Graphs with fewer edge pairs per thread are solved by 'traceEulerianCircuit()',
+ * since starting the threads would take longer than the whole walk.
+ */
+#define PARALLELCIRCUIT_MIN_EDGES_PER_THREAD    ( 1 << 16 )
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Finds an eulerian cycle or path like 'traceEulerianCircuit()', but with many threads. The graph isn't changed.
+ *
+ * Instead of walking the graph, every vertex pairs up its edge ends: an edge that arrives at a vertex leaves
+ * along its partner. This splits the edges into closed trails, which are told apart with a union-find built by all threads.
+ * Whenever two pairs of a vertex belong to different trails, swapping their partners merges the two trails into one,
+ * until every vertex only sees one trail. For a path, a virtual edge pair between the two vertices with uneven degree
+ * closes the trail and is cut off again in the end.
+ * Finally, the trail is cut into pieces at some edges, the pieces are measured and then written to their place in parallel.
+ *
+ * Every step either works on the vertices of a thread or on independent pieces, so the only shared writes are
+ * the union-find links, which are made with compare-and-swap. The order of the vertices differs from
+ * the sequential algorithms, but it is a valid eulerian cycle or path all the same.
+ * @param graph
+ * @param graphInfo
+ * @param workspace The arrays for 'traceEulerianCircuit()' if the graph is too small for threads.
+ * @param vertices Receives the vertex numbers of the cycle or path.
+ * @param length The number of vertex numbers to write, which must be 'getEulerianCircuitLength()'.
+ * @param threadCount The maximum number of threads.
+ * @return true, if all edges have been reached. Otherwise the graph is disconnected and the vertices are incomplete.
+ */
+bool traceEulerianCircuitParallel( Graph *graph, GraphInformation graphInfo, CircuitWorkspace *workspace,
+                                   int *vertices, size_t length, int threadCount );
+
+
+/**
+ * @brief Finds an eulerian cycle with 'traceEulerianCircuitParallel()'.
+ * @param graph
+ * @param graphInfo
+ * @param threadCount The maximum number of threads.
+ * @return The cycle. The vertex array must be freed by the caller.
+ */
+EulerianCircuit findEulerianCircuitParallel( Graph *graph, GraphInformation graphInfo, int threadCount );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // PARALLELCIRCUIT
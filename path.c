@@ -3,10 +3,55 @@
 
 Path *path_new( void )
 {
-    Path *path = (Path *) malloc( sizeof( Path ));
-    assert( path != NULL );
+    return path_newWithBackend( LIST_BACKEND_LINKED );
+}
+
+
+Path *path_newWithBackend( ListBackend backend )
+{
+    return path_newWithAllocator( backend, NULL );
+}
+
+
+Path *path_newWithAllocator( ListBackend backend, const Allocator *allocator )
+{
+    if( allocator == NULL )
+        allocator = allocator_getDefault();
+
+    Path *path = (Path *) allocator_allocate( allocator, sizeof( Path ));
 
-    path->elements = dList_new( sizeof( PathElement ), (DestroyFunction) pathElement_destroy );
+    path->backend = backend;
+    path->elements = NULL;
+    path->unrolledElements = NULL;
+    path->allocator = allocator;
+
+    if( backend == LIST_BACKEND_UNROLLED )
+        path->unrolledElements = uList_newWithAllocator( sizeof( PathElement ), allocator );
+    else
+        path->elements = dList_newInlineWithOwnNodePool( sizeof( PathElement ), PATH_NODES_PER_SLAB, allocator );
+
+    return path;
+}
+
+
+Path *path_newForMerging( Path *path )
+{
+    // The chunks of unrolled lists are moved as they are, so they only need the same allocator.
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        return path_newWithAllocator( LIST_BACKEND_UNROLLED, path->allocator );
+
+    return path_newWithNodePool( dList_getNodePool( path->elements ));
+}
+
+
+Path *path_newWithNodePool( DListNodePool *nodePool )
+{
+    Path *path = (Path *) allocator_allocate( nodePool->allocator, sizeof( Path ));
+
+    path->backend = LIST_BACKEND_LINKED;
+    path->elements = dList_newInline( sizeof( PathElement ), nodePool );
+    path->unrolledElements = NULL;
+    path->allocator = nodePool->allocator;
 
     return path;
 }
@@ -14,15 +59,18 @@ Path *path_new( void )
 
 void path_destroy( Path *path )
 {
-    free( path );
+    allocator_release( path->allocator, path, sizeof( Path ));
     return;
 }
 
 
 void path_destroyAll( Path *path )
 {
-    dList_destroyAll( path->elements );
-    free( path );
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uList_destroyAll( path->unrolledElements );
+    else
+        dList_destroyAll( path->elements );
+    allocator_release( path->allocator, path, sizeof( Path ));
     return;
 }
 
@@ -33,9 +81,34 @@ DList *path_getElements( Path *path )
 }
 
 
+UList *path_getUnrolledElements( Path *path )
+{
+    return path->unrolledElements;
+}
+
+
+ListBackend path_getBackend( Path *path )
+{
+    return path->backend;
+}
+
+
+int path_getSize( Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        return uList_getSize( path->unrolledElements );
+
+    return dList_getSize( path->elements );
+}
+
+
 void path_append( Path *path, int vertexNum )
 {
-    PathElement *newElement = pathElement_new( vertexNum );
-    dList_append( path->elements, newElement );
+    // The list stores a copy of the element.
+    PathElement newElement = { vertexNum };
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uList_append( path->unrolledElements, &newElement );
+    else
+        dList_append( path->elements, &newElement );
     return;
 }
@@ -12,15 +12,29 @@
 
 #include "basic.h"
 #include "dlist.h"
+#include "ulist.h"
 #include "pathelement.h"
+#include "allocator.h"
+
+
+/**
+ * @brief The number of path nodes a path with a pool of its own allocates at once.
+ */
+#define PATH_NODES_PER_SLAB     4096
 
 
 /**
  * @brief This is just a container for a list of path elements which simply represent the vertices.
+ * The list stores the path elements inline.
+ * Depending on the backend, the list is either a DList or an unrolled UList.
+ * Use a PathIterator to walk the path regardless of the backend.
  */
 typedef struct
 {
-    DList *elements;    /**< The list of path elements. */
+    ListBackend backend;            /**< Tells which of the lists is used. */
+    DList *     elements;           /**< The list of path elements if the backend is linked. */
+    UList *     unrolledElements;   /**< The list of path elements if the backend is unrolled. */
+    const Allocator *allocator;     /**< The allocator of the path and its list. */
 } Path;
 
 
@@ -31,11 +45,50 @@ extern "C" {
 
 /**
  * @brief Allocates and initializes the path.
+ * The path creates a pool of its own for its nodes which is released together with the path.
  * @return  The pointer to the new path.
  */
 Path *path_new( void );
 
 
+/**
+ * @brief Allocates and initializes the path using the given backend.
+ * A linked path creates a pool of its own like 'path_new()' does.
+ * @param backend
+ * @return  The pointer to the new path.
+ */
+Path *path_newWithBackend( ListBackend backend );
+
+
+/**
+ * @brief Allocates and initializes the path using the given backend which takes all its memory from the given allocator.
+ * The list, its pool or its chunks, and the paths created by 'path_newForMerging()' use the same allocator.
+ * @param backend
+ * @param allocator The allocator or NULL for the default allocator. It must outlive the path.
+ * @return  The pointer to the new path.
+ */
+Path *path_newWithAllocator( ListBackend backend, const Allocator *allocator );
+
+
+/**
+ * @brief Allocates and initializes an empty path which can be merged into the given path later on.
+ * It uses the same backend and allocator and, if it is linked, takes its nodes from the pool of the given path.
+ * @param path
+ * @return  The pointer to the new path.
+ */
+Path *path_newForMerging( Path *path );
+
+
+/**
+ * @brief Allocates and initializes a linked path whose nodes are taken from a pool it doesn't own.
+ * Use this for paths which are merged into another path: they must share the pool of that path.
+ * The path is allocated by the allocator of the pool.
+ * @param nodePool A pool whose payload size is the size of a path element.
+ * @return  The pointer to the new path.
+ */
+Path *path_newWithNodePool( DListNodePool *nodePool );
+
+
 /**
  * @brief Simply frees the pointer to the path.
  * @param path
@@ -52,11 +105,32 @@ void path_destroyAll( Path *path );
 
 /**
  * @param path
- * @return The list of path elements.
+ * @return The list of path elements if the backend is linked.
  */
 DList *path_getElements( Path *path );
 
 
+/**
+ * @param path
+ * @return The list of path elements if the backend is unrolled.
+ */
+UList *path_getUnrolledElements( Path *path );
+
+
+/**
+ * @param path
+ * @return The backend of the path.
+ */
+ListBackend path_getBackend( Path *path );
+
+
+/**
+ * @param path
+ * @return The number of elements of the path.
+ */
+int path_getSize( Path *path );
+
+
 /**
  * @brief Appends a path element with the specified vertex number to the path.
  * @param path
@@ -0,0 +1,90 @@
+#include "pathiterator.h"
+
+
+void pathIterator_toFirst( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uListIterator_toFirst( &iterator->position, path->unrolledElements );
+    else
+        dListIterator_toFirst( iterator->node, path->elements );
+    return;
+}
+
+
+void pathIterator_toLast( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uListIterator_toLast( &iterator->position, path->unrolledElements );
+    else
+        dListIterator_toLast( iterator->node, path->elements );
+    return;
+}
+
+
+void pathIterator_increment( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uListIterator_increment( &iterator->position );
+    else
+        dListIterator_increment( iterator->node );
+    return;
+}
+
+
+bool pathIterator_isAtEnd( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        return uListIterator_isAtEnd( &iterator->position );
+
+    return dListIterator_isAtEnd( iterator->node, path->elements );
+}
+
+
+PathElement *pathIterator_get( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        return (PathElement *) uListIterator_get( &iterator->position, path->unrolledElements );
+
+    return (PathElement *) dListIterator_get( iterator->node );
+}
+
+
+void pathIterator_destroy( PathIterator *iterator, Path *path )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uListIterator_destroy( &iterator->position, path->unrolledElements );
+    else
+        dListIterator_destroy( iterator->node, path->elements );
+    return;
+}
+
+
+PathElement *pathIterator_search( PathIterator *iterator, Path *path, Comparator *comparator )
+{
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        return (PathElement *) uListIterator_search( &iterator->position, path->unrolledElements, comparator );
+
+    return (PathElement *) dListIterator_search( &iterator->node, path->elements, comparator );
+}
+
+
+void pathIterator_merge( PathIterator *iterator, Path *path, Path *subPath )
+{
+    assert( path->backend == subPath->backend );
+
+    // The lists don't merge empty lists, so we destroy it ourselves.
+    if( path_getSize( subPath ) == 0 )
+    {
+        path_destroyAll( subPath );
+        return;
+    }
+
+    // The merge functions of the lists destroy the merged list, so only the container of the sub-path is left.
+    if( path->backend == LIST_BACKEND_UNROLLED )
+        uListIterator_merge( &iterator->position, path->unrolledElements, subPath->unrolledElements );
+    else
+        dListIterator_merge( &iterator->node, path->elements, subPath->elements );
+
+    path_destroy( subPath );
+    return;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file pathiterator.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A bidirectional iterator for a path which works for every backend of the path.
+ */
+
+
+#ifndef PATHITERATOR
+#define PATHITERATOR
+
+
+#include "basic.h"
+#include "path.h"
+#include "pathelement.h"
+#include "dlistiterator.h"
+#include "ulistiterator.h"
+#include "comparator.h"
+
+
+/**
+ * @brief An iterator over the elements of a path.
+ * Only the member which matches the backend of the path is used.
+ */
+typedef struct
+{
+    DListIterator * node;       /**< The current node if the path is linked. */
+    UListIterator   position;   /**< The current position if the path is unrolled. */
+} PathIterator;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Sets the iterator to the first element of the path.
+ * @param iterator
+ * @param path
+ */
+void pathIterator_toFirst( PathIterator *iterator, Path *path );
+
+
+/**
+ * @brief Sets the iterator to the last element of the path.
+ * @param iterator
+ * @param path
+ */
+void pathIterator_toLast( PathIterator *iterator, Path *path );
+
+
+/**
+ * @brief Sets the iterator to the next element of the path.
+ * @param iterator
+ * @param path
+ *
+ * @attention Do not increment if the iterator is at the end!
+ */
+void pathIterator_increment( PathIterator *iterator, Path *path );
+
+
+/**
+ * @param iterator
+ * @param path
+ * @return true, if the iterator walked off the end of the path.
+ */
+bool pathIterator_isAtEnd( PathIterator *iterator, Path *path );
+
+
+/**
+ * @param iterator
+ * @param path
+ * @return The element of the iterator.
+ */
+PathElement *pathIterator_get( PathIterator *iterator, Path *path );
+
+
+/**
+ * @brief Removes the element of the iterator from the path.
+ * @param iterator
+ * @param path
+ *
+ * @attention You cannot use the iterator anymore after calling this function!
+ */
+void pathIterator_destroy( PathIterator *iterator, Path *path );
+
+
+/**
+ * @brief Uses a comparator object to search an element of the path, starting at the current element.
+ * @param iterator
+ * @param path
+ * @param comparator
+ * @return The element to search for if it is found, else NULL. In the latter case, the iterator is at the end.
+ */
+PathElement *pathIterator_search( PathIterator *iterator, Path *path, Comparator *comparator );
+
+
+/**
+ * @brief Replaces the element of the iterator with the elements of the sub-path.
+ * The sub-path must have been created with 'path_newForMerging()' from the path.
+ * @param iterator Is set to the first merged element.
+ * @param path
+ * @param subPath
+ *
+ * @attention The sub-path is completely destroyed by this function! So do not access it anymore!
+ */
+void pathIterator_merge( PathIterator *iterator, Path *path, Path *subPath );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // PATHITERATOR
@@ -0,0 +1,554 @@
+#include "resultcache.h"
+#include "string.h"
+#include "limits.h"
+#include "unistd.h"
+#include "fcntl.h"
+#include "sys/stat.h"
+
+
+/**
+ * @brief The number of buckets of a new cache.
+ */
+#define RESULTCACHE_INITIAL_BUCKET_COUNT    1024
+
+
+/**
+ * @brief The most bytes a compressed vertex number can take: a 33-bit difference needs five groups of 7 bits.
+ */
+#define RESULTCACHE_MAX_BYTES_PER_VERTEX    5
+
+
+// Multipliers with well mixed bits, as used by common 64-bit hashes.
+#define PRIME_1     0x9E3779B185EBCA87ULL
+#define PRIME_2     0xC2B2AE3D27D4EB4FULL
+#define PRIME_3     0x165667B19E3779F9ULL
+#define PRIME_4     0x85EBCA77C2B2AE63ULL
+
+
+static uint64_t rotate( uint64_t value, int count )
+{
+    return ( value << count ) | ( value >> ( 64 - count ));
+}
+
+
+/**
+ * @brief Spreads every input bit over all output bits.
+ */
+static uint64_t avalanche( uint64_t value )
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+
+ResultCacheKey resultCache_hash( const void *data, size_t size )
+{
+    const unsigned char *bytes = (const unsigned char *) data;
+    uint64_t low = PRIME_1 ^ (uint64_t) size;
+    uint64_t high = PRIME_3 + (uint64_t) size;
+
+    // Both halves consume the same words with different constants.
+    size_t position = 0;
+    uint64_t word;
+    for( ; position + 8 <= size; position += 8 )
+    {
+        memcpy( &word, bytes + position, 8 );
+        low = rotate( low ^ ( word * PRIME_2 ), 31 ) * PRIME_1;
+        high = rotate( high ^ ( word * PRIME_4 ), 27 ) * PRIME_3;
+    }
+
+    // The last bytes are padded with zeros. The size is part of the seed, so padding doesn't collide.
+    if( position < size )
+    {
+        word = 0;
+        memcpy( &word, bytes + position, size - position );
+        low = rotate( low ^ ( word * PRIME_2 ), 31 ) * PRIME_1;
+        high = rotate( high ^ ( word * PRIME_4 ), 27 ) * PRIME_3;
+    }
+
+    ResultCacheKey key;
+    key.low = avalanche( low ^ rotate( high, 17 ));
+    key.high = avalanche( high + low * PRIME_2 );
+    return key;
+}
+
+
+/**
+ * @brief Compresses a path into a new entry. The links of the entry are left for the caller.
+ */
+static ResultCacheEntry *compressEntry( ResultCacheKey key, EulerianStatus status, const int *vertices, size_t length )
+{
+    unsigned char *buffer = (unsigned char *) malloc( length * RESULTCACHE_MAX_BYTES_PER_VERTEX + 1 );
+    assert( buffer != NULL );
+
+    size_t size = 0;
+    int64_t previous = 0;
+    size_t position;
+    for( position = 0; position < length; position++ )
+    {
+        // Zigzag-encoding maps small negative differences to small numbers as well.
+        int64_t difference = (int64_t) vertices[ position ] - previous;
+        uint64_t value = ( (uint64_t) difference << 1 ) ^ (uint64_t) ( difference >> 63 );
+        previous = vertices[ position ];
+
+        while( value >= 0x80 )
+        {
+            buffer[ size++ ] = (unsigned char) ( value | 0x80 );
+            value >>= 7;
+        }
+        buffer[ size++ ] = (unsigned char) value;
+    }
+
+    ResultCacheEntry *entry = (ResultCacheEntry *) malloc( sizeof( ResultCacheEntry ) + size );
+    assert( entry != NULL );
+
+    entry->nextInBucket = NULL;
+    entry->newer = NULL;
+    entry->older = NULL;
+    entry->key = key;
+    entry->status = status;
+    entry->length = length;
+    entry->compressedSize = size;
+    memcpy( entry->compressed, buffer, size );
+
+    free( buffer );
+    return entry;
+}
+
+
+/**
+ * @brief Decompresses the path of an entry.
+ * @return false, if the compressed data is corrupt, which can only happen to entries read from disk.
+ */
+static bool decompressEntry( const ResultCacheEntry *entry, int *vertices )
+{
+    size_t position = 0;
+    int64_t previous = 0;
+    size_t vertexNum;
+    for( vertexNum = 0; vertexNum < entry->length; vertexNum++ )
+    {
+        uint64_t value = 0;
+        int shift = 0;
+        while( true )
+        {
+            if( position >= entry->compressedSize || shift > 28 )
+                return false;
+
+            unsigned char byte = entry->compressed[ position++ ];
+            value |= (uint64_t) ( byte & 0x7F ) << shift;
+            shift += 7;
+            if( !( byte & 0x80 ))
+                break;
+        }
+
+        int64_t vertex = previous + (int64_t) (( value >> 1 ) ^ ( ~( value & 1 ) + 1 ));
+        if( vertex < 0 || vertex > INT_MAX )
+            return false;
+
+        vertices[ vertexNum ] = (int) vertex;
+        previous = vertex;
+    }
+
+    return position == entry->compressedSize;
+}
+
+
+/**
+ * @brief The bytes an entry takes from the budget.
+ */
+static size_t entrySize( const ResultCacheEntry *entry )
+{
+    return sizeof( ResultCacheEntry ) + entry->compressedSize;
+}
+
+
+static bool keysEqual( ResultCacheKey key1, ResultCacheKey key2 )
+{
+    return key1.low == key2.low && key1.high == key2.high;
+}
+
+
+static ResultCacheEntry **findSlot( ResultCache *cache, ResultCacheKey key )
+{
+    ResultCacheEntry **slot = &cache->buckets[ key.low & ( cache->bucketCount - 1 ) ];
+    while( *slot != NULL && !keysEqual(( *slot )->key, key ))
+        slot = &( *slot )->nextInBucket;
+
+    return slot;
+}
+
+
+/**
+ * @brief Unlinks an entry from the list of recently used entries.
+ */
+static void unlinkEntry( ResultCache *cache, ResultCacheEntry *entry )
+{
+    if( entry->newer != NULL )
+        entry->newer->older = entry->older;
+    else
+        cache->newest = entry->older;
+
+    if( entry->older != NULL )
+        entry->older->newer = entry->newer;
+    else
+        cache->oldest = entry->newer;
+
+    entry->newer = NULL;
+    entry->older = NULL;
+    return;
+}
+
+
+/**
+ * @brief Makes an unlinked entry the most recently used one.
+ */
+static void linkNewest( ResultCache *cache, ResultCacheEntry *entry )
+{
+    entry->older = cache->newest;
+    entry->newer = NULL;
+    if( cache->newest != NULL )
+        cache->newest->newer = entry;
+    else
+        cache->oldest = entry;
+    cache->newest = entry;
+    return;
+}
+
+
+/**
+ * @brief Doubles the number of buckets and rehashes all entries.
+ */
+static void growBuckets( ResultCache *cache )
+{
+    size_t bucketCount = 2 * cache->bucketCount;
+    ResultCacheEntry **buckets = (ResultCacheEntry **) calloc( bucketCount, sizeof( ResultCacheEntry * ));
+    assert( buckets != NULL );
+
+    size_t bucketNum;
+    for( bucketNum = 0; bucketNum < cache->bucketCount; bucketNum++ )
+    {
+        ResultCacheEntry *entry = cache->buckets[ bucketNum ];
+        while( entry != NULL )
+        {
+            ResultCacheEntry *next = entry->nextInBucket;
+            ResultCacheEntry **bucket = &buckets[ entry->key.low & ( bucketCount - 1 ) ];
+            entry->nextInBucket = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+
+    free( cache->buckets );
+    cache->buckets = buckets;
+    cache->bucketCount = bucketCount;
+    return;
+}
+
+
+/**
+ * @brief Drops the least recently used entries until the budget is kept. The caller holds the mutex.
+ */
+static void evict( ResultCache *cache )
+{
+    while( cache->byteCount > cache->byteBudget && cache->oldest != NULL )
+    {
+        ResultCacheEntry *entry = cache->oldest;
+        ResultCacheEntry **slot = findSlot( cache, entry->key );
+        *slot = entry->nextInBucket;
+
+        unlinkEntry( cache, entry );
+        cache->byteCount -= entrySize( entry );
+        cache->entryCount--;
+        free( entry );
+    }
+
+    return;
+}
+
+
+/**
+ * @brief Adds an entry in memory, or frees it if the key is already there or it doesn't fit into the budget.
+ */
+static void insertEntry( ResultCache *cache, ResultCacheEntry *entry )
+{
+    if( entrySize( entry ) > cache->byteBudget )
+    {
+        free( entry );
+        return;
+    }
+
+    pthread_mutex_lock( &cache->mutex );
+
+    ResultCacheEntry **slot = findSlot( cache, entry->key );
+    if( *slot != NULL )
+    {
+        // Another worker has solved the same graph in the meantime.
+        pthread_mutex_unlock( &cache->mutex );
+        free( entry );
+        return;
+    }
+
+    *slot = entry;
+    linkNewest( cache, entry );
+    cache->byteCount += entrySize( entry );
+    cache->entryCount++;
+
+    evict( cache );
+    if( cache->entryCount > cache->bucketCount )
+        growBuckets( cache );
+
+    pthread_mutex_unlock( &cache->mutex );
+    return;
+}
+
+
+/**
+ * @brief Builds the path of the result file of a key, or of a temporary file if the suffix is "XXXXXX".
+ */
+static char *filePath( ResultCache *cache, ResultCacheKey key, const char *suffix )
+{
+    size_t size = strlen( cache->directory ) + 1 + 32 + 1 + strlen( suffix ) + 1;
+    char *path = (char *) malloc( size );
+    assert( path != NULL );
+
+    snprintf( path, size, "%s/%016llx%016llx.%s", cache->directory,
+              (unsigned long long) key.high, (unsigned long long) key.low, suffix );
+    return path;
+}
+
+
+/**
+ * @brief Reads exactly size bytes.
+ */
+static bool readFully( int fd, void *data, size_t size )
+{
+    while( size > 0 )
+    {
+        ssize_t bytesRead = read( fd, data, size );
+        if( bytesRead <= 0 )
+            return false;
+
+        data = (char *) data + bytesRead;
+        size -= (size_t) bytesRead;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Writes exactly size bytes.
+ */
+static bool writeFully( int fd, const void *data, size_t size )
+{
+    while( size > 0 )
+    {
+        ssize_t bytesWritten = write( fd, data, size );
+        if( bytesWritten <= 0 )
+            return false;
+
+        data = (const char *) data + bytesWritten;
+        size -= (size_t) bytesWritten;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Reads the result file of a key.
+ * @return The entry or NULL, if there is no valid file.
+ */
+static ResultCacheEntry *readFile( ResultCache *cache, ResultCacheKey key )
+{
+    char *path = filePath( cache, key, "res" );
+    int fd = open( path, O_RDONLY );
+    free( path );
+    if( fd < 0 )
+        return NULL;
+
+    ResultCacheFileHeader header;
+    struct stat fileStat;
+    if( fstat( fd, &fileStat ) != 0 || !readFully( fd, &header, sizeof( header )) ||
+        memcmp( header.magic, RESULTCACHE_FILE_MAGIC, sizeof( header.magic )) != 0 ||
+        header.version != RESULTCACHE_FILE_VERSION || header.byteOrderMark != 0x01020304 ||
+        header.keyLow != key.low || header.keyHigh != key.high ||
+        header.hasPath > 1 || header.length > header.compressedSize ||
+        (uint64_t) fileStat.st_size != sizeof( header ) + header.compressedSize )
+    {
+        close( fd );
+        return NULL;
+    }
+
+    ResultCacheEntry *entry = (ResultCacheEntry *) malloc( sizeof( ResultCacheEntry ) + (size_t) header.compressedSize );
+    assert( entry != NULL );
+
+    entry->nextInBucket = NULL;
+    entry->newer = NULL;
+    entry->older = NULL;
+    entry->key = key;
+    entry->status = header.hasPath ? EULERIAN_OK : EULERIAN_NO_PATH;
+    entry->length = (size_t) header.length;
+    entry->compressedSize = (size_t) header.compressedSize;
+
+    bool complete = readFully( fd, entry->compressed, entry->compressedSize );
+    close( fd );
+    if( !complete )
+    {
+        free( entry );
+        return NULL;
+    }
+
+    return entry;
+}
+
+
+/**
+ * @brief Writes the result file of an entry. It's written to a temporary file first and renamed,
+ * so readers never see a partial file. Failures are ignored, the result just isn't stored on disk.
+ */
+static void writeFile( ResultCache *cache, const ResultCacheEntry *entry )
+{
+    ResultCacheFileHeader header;
+    memset( &header, 0, sizeof( header ));
+    memcpy( header.magic, RESULTCACHE_FILE_MAGIC, sizeof( header.magic ));
+    header.version = RESULTCACHE_FILE_VERSION;
+    header.byteOrderMark = 0x01020304;
+    header.keyLow = entry->key.low;
+    header.keyHigh = entry->key.high;
+    header.hasPath = ( entry->status == EULERIAN_OK );
+    header.length = entry->length;
+    header.compressedSize = entry->compressedSize;
+
+    char *temporaryPath = filePath( cache, entry->key, "XXXXXX" );
+    int fd = mkstemp( temporaryPath );
+    if( fd < 0 )
+    {
+        free( temporaryPath );
+        return;
+    }
+
+    bool written = writeFully( fd, &header, sizeof( header )) &&
+                   writeFully( fd, entry->compressed, entry->compressedSize );
+    written = ( close( fd ) == 0 ) && written;
+
+    char *path = filePath( cache, entry->key, "res" );
+    if( !written || rename( temporaryPath, path ) != 0 )
+        unlink( temporaryPath );
+
+    free( path );
+    free( temporaryPath );
+    return;
+}
+
+
+ResultCache *resultCache_new( size_t byteBudget, const char *directory )
+{
+    ResultCache *cache = (ResultCache *) malloc( sizeof( ResultCache ));
+    assert( cache != NULL );
+
+    cache->bucketCount = RESULTCACHE_INITIAL_BUCKET_COUNT;
+    cache->buckets = (ResultCacheEntry **) calloc( cache->bucketCount, sizeof( ResultCacheEntry * ));
+    assert( cache->buckets != NULL );
+
+    cache->entryCount = 0;
+    cache->byteCount = 0;
+    cache->byteBudget = byteBudget;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->directory = ( directory != NULL ) ? strdup( directory ) : NULL;
+    pthread_mutex_init( &cache->mutex, NULL );
+
+    return cache;
+}
+
+
+void resultCache_destroy( ResultCache *cache )
+{
+    ResultCacheEntry *entry = cache->newest;
+    while( entry != NULL )
+    {
+        ResultCacheEntry *older = entry->older;
+        free( entry );
+        entry = older;
+    }
+
+    pthread_mutex_destroy( &cache->mutex );
+    free( cache->directory );
+    free( cache->buckets );
+    free( cache );
+    return;
+}
+
+
+bool resultCache_lookup( ResultCache *cache, ResultCacheKey key, EulerianStatus *status, int **vertices, size_t *length )
+{
+    // Copy the entry while holding the mutex and decompress it without, since another worker may drop it.
+    ResultCacheEntry *copy = NULL;
+
+    pthread_mutex_lock( &cache->mutex );
+    ResultCacheEntry *entry = *findSlot( cache, key );
+    if( entry != NULL )
+    {
+        unlinkEntry( cache, entry );
+        linkNewest( cache, entry );
+
+        copy = (ResultCacheEntry *) malloc( entrySize( entry ));
+        assert( copy != NULL );
+        memcpy( copy, entry, entrySize( entry ));
+    }
+    pthread_mutex_unlock( &cache->mutex );
+
+    bool fromDisk = false;
+    if( copy == NULL && cache->directory != NULL )
+    {
+        copy = readFile( cache, key );
+        fromDisk = true;
+    }
+
+    if( copy == NULL )
+        return false;
+
+    int *path = (int *) malloc(( copy->length > 0 ? copy->length : 1 ) * sizeof( int ));
+    assert( path != NULL );
+
+    if( !decompressEntry( copy, path ))
+    {
+        free( path );
+        free( copy );
+        return false;
+    }
+
+    *status = copy->status;
+    *vertices = path;
+    *length = copy->length;
+
+    if( fromDisk )
+        insertEntry( cache, copy );
+    else
+        free( copy );
+
+    return true;
+}
+
+
+void resultCache_store( ResultCache *cache, ResultCacheKey key, EulerianStatus status, const int *vertices, size_t length )
+{
+    if( status != EULERIAN_OK && status != EULERIAN_NO_PATH )
+        return;
+
+    if( status == EULERIAN_NO_PATH )
+        length = 0;
+
+    ResultCacheEntry *entry = compressEntry( key, status, vertices, length );
+
+    if( cache->directory != NULL )
+        writeFile( cache, entry );
+
+    insertEntry( cache, entry );
+    return;
+}
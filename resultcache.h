@@ -0,0 +1,164 @@
+/**
+ * @file resultcache.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief Remembers the results of graphs which have been solved before.
+ */
+
+
+#ifndef RESULTCACHE
+#define RESULTCACHE
+
+
+#include "basic.h"
+#include "eulerian.h"
+#include "stdint.h"
+#include "pthread.h"
+
+
+/**
+ * @brief The memory budget in megabytes when only a disk store is asked for.
+ */
+#define RESULTCACHE_DEFAULT_MEGABYTES   256
+
+
+/**
+ * @brief The first bytes of a result file in the disk store.
+ */
+#define RESULTCACHE_FILE_MAGIC      "EULERRES"
+
+
+/**
+ * @brief The version of the result file format. It must be increased whenever the layout or the compression changes.
+ */
+#define RESULTCACHE_FILE_VERSION    1
+
+
+/**
+ * @brief The 128-bit hash of a submitted graph, which is the key of its result.
+ */
+typedef struct
+{
+    uint64_t    low;            /**< The first 64 bits. */
+    uint64_t    high;           /**< The second 64 bits, computed with other constants. */
+} ResultCacheKey;
+
+
+/**
+ * @brief A cached result.
+ * The path is stored as the differences between consecutive vertex numbers, zigzag-encoded as variable length integers.
+ * Neighboring vertices often have similar numbers, so most vertices take one or two bytes instead of four.
+ */
+typedef struct ResultCacheEntry
+{
+    struct ResultCacheEntry *   nextInBucket;       /**< The next entry in the same hash bucket. */
+    struct ResultCacheEntry *   newer;              /**< The entry which has been used after this one. */
+    struct ResultCacheEntry *   older;              /**< The entry which has been used before this one. */
+    ResultCacheKey              key;                /**< The hash of the graph. */
+    EulerianStatus              status;             /**< EULERIAN_OK or EULERIAN_NO_PATH. */
+    size_t                      length;             /**< The number of vertex numbers of the path. */
+    size_t                      compressedSize;     /**< The number of bytes of the compressed path. */
+    unsigned char               compressed[];       /**< The compressed path. */
+} ResultCacheEntry;
+
+
+/**
+ * @brief The header of a result file in the disk store.
+ * The file is named after the key and holds the compressed path right behind the header.
+ */
+typedef struct
+{
+    char        magic[ 8 ];         /**< RESULTCACHE_FILE_MAGIC without the terminating zero. */
+    uint32_t    version;            /**< RESULTCACHE_FILE_VERSION */
+    uint32_t    byteOrderMark;      /**< 0x01020304 in the byte order of the writer. */
+    uint64_t    keyLow;             /**< The key again, to detect renamed files. */
+    uint64_t    keyHigh;
+    uint32_t    hasPath;            /**< 1 for EULERIAN_OK, 0 for EULERIAN_NO_PATH. */
+    uint32_t    reserved;
+    uint64_t    length;             /**< The number of vertex numbers of the path. */
+    uint64_t    compressedSize;     /**< The number of bytes of the compressed path. */
+} ResultCacheFileHeader;
+
+
+/**
+ * @brief A thread-safe map from graph hashes to results, limited to a number of bytes.
+ *
+ * When the entries take more than the budget, the least recently used ones are dropped.
+ * With a directory, every stored result is also written to disk, and results which aren't in memory
+ * are looked up there before giving up, so they survive a restart.
+ * Only paths and "no path" results are cached; format errors are cheap to find again.
+ */
+typedef struct
+{
+    ResultCacheEntry ** buckets;        /**< The hash table of the entries. */
+    size_t              bucketCount;    /**< The number of buckets, a power of 2. */
+    size_t              entryCount;     /**< The number of entries. */
+    size_t              byteCount;      /**< The bytes taken by all entries. */
+    size_t              byteBudget;     /**< The maximum of byteCount. */
+    ResultCacheEntry *  newest;         /**< The most recently used entry. */
+    ResultCacheEntry *  oldest;         /**< The least recently used entry, which is dropped first. */
+    char *              directory;      /**< The directory of the disk store or NULL. */
+    pthread_mutex_t     mutex;          /**< Protects everything in memory. */
+} ResultCache;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Creates a new result cache.
+ * @param byteBudget The number of bytes which the entries may take in memory.
+ * @param directory The directory of the disk store or NULL to keep the results in memory only. It must exist.
+ * @return The new result cache.
+ */
+ResultCache *resultCache_new( size_t byteBudget, const char *directory );
+
+
+/**
+ * @brief Destroys a result cache. The disk store is kept.
+ * @param cache The result cache.
+ */
+void resultCache_destroy( ResultCache *cache );
+
+
+/**
+ * @brief Computes the key of a submitted graph. It hashes 8 bytes per step, so it takes far less time than parsing.
+ * Only byte-identical submissions have the same key.
+ * @param data The graph as submitted, in the text or binary format.
+ * @param size The number of bytes.
+ * @return The key.
+ */
+ResultCacheKey resultCache_hash( const void *data, size_t size );
+
+
+/**
+ * @brief Looks up a result, first in memory and then in the disk store. A hit becomes the most recently used entry.
+ * @param cache The result cache.
+ * @param key The key of the graph.
+ * @param status Receives EULERIAN_OK or EULERIAN_NO_PATH.
+ * @param vertices Receives the path, allocated with malloc, or NULL if there is none.
+ * @param length Receives the number of vertex numbers of the path.
+ * @return true, if the result was found.
+ */
+bool resultCache_lookup( ResultCache *cache, ResultCacheKey key, EulerianStatus *status, int **vertices, size_t *length );
+
+
+/**
+ * @brief Stores a result in memory and in the disk store. Other statuses than EULERIAN_OK and EULERIAN_NO_PATH are ignored.
+ * @param cache The result cache.
+ * @param key The key of the graph.
+ * @param status The result of solving the graph.
+ * @param vertices The path if the status is EULERIAN_OK.
+ * @param length The number of vertex numbers of the path.
+ */
+void resultCache_store( ResultCache *cache, ResultCacheKey key, EulerianStatus status, const int *vertices, size_t length );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // RESULTCACHE
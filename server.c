@@ -0,0 +1,705 @@
+#include "server.h"
+#include "eulerian.h"
+#include "outputwriter.h"
+#include "string.h"
+#include "errno.h"
+#include "signal.h"
+#include "time.h"
+#include "pthread.h"
+#include "unistd.h"
+#include "sys/socket.h"
+#include "sys/un.h"
+
+
+/**
+ * @brief The size of the receive buffer of a connection. The payload of a request starts with this size and doubles as its data arrives.
+ */
+#define SERVER_READ_BUFFER_SIZE         ( 1 << 16 )
+
+
+/**
+ * @brief The number of jobs per worker which may wait in the queue. When the queue is full, the connections stop reading.
+ */
+#define SERVER_QUEUED_JOBS_PER_WORKER   4
+
+
+/**
+ * @brief The result of reading a request header.
+ */
+typedef enum
+{
+    HEADER_OK = 0,                  /**< The header is valid. */
+    HEADER_END,                     /**< The connection ended. */
+    HEADER_INVALID,                 /**< The header isn't "<id> <size>\n". */
+    HEADER_TOO_LARGE                /**< The request is larger than the server accepts. */
+} HeaderResult;
+
+
+typedef struct Connection Connection;
+
+
+/**
+ * @brief A submitted graph and, once a worker is done with it, its result.
+ */
+typedef struct Job
+{
+    struct Job *        nextQueued;         /**< The next job waiting for a worker. */
+    struct Job *        nextInConnection;   /**< The next job of the same connection. */
+    Connection *        connection;         /**< The connection which receives the response. */
+    unsigned long long  id;                 /**< The id chosen by the client. */
+    char *              payload;            /**< The graph data. */
+    size_t              size;               /**< The number of bytes of graph data. */
+    EulerianStatus      status;             /**< The result of loading and solving. */
+    int *               vertices;           /**< The eulerian path if the status is EULERIAN_OK. */
+    size_t              length;             /**< The number of vertex numbers of the path. */
+    int                 errorLine;          /**< The line of a format error or 0. */
+    int                 errorColumn;        /**< The column of a format error or 0. */
+    const char *        errorMessage;       /**< Why the graph couldn't be loaded. */
+    const char *        refusal;            /**< Why the request got no result, or NULL. */
+    long long           receivedAt;         /**< When the request was complete, in nanoseconds. */
+    long long           startedAt;          /**< When a worker took the job. */
+    long long           loadedAt;           /**< When the graph was loaded. */
+    long long           finishedAt;         /**< When the result was ready. */
+    bool                done;               /**< true, if the result is ready. Protected by the connection's mutex. */
+} Job;
+
+
+/**
+ * @brief The queue of jobs which the workers share.
+ */
+typedef struct
+{
+    Job *               first;              /**< The oldest job waiting for a worker. */
+    Job *               last;               /**< The newest job waiting for a worker. */
+    int                 count;              /**< The number of jobs waiting for a worker, including those still being received. */
+    int                 capacity;           /**< The number of jobs which may wait at once. */
+    pthread_mutex_t     mutex;              /**< Protects the queue. */
+    pthread_cond_t      jobQueued;          /**< Signaled whenever a job is queued. */
+    pthread_cond_t      jobTaken;           /**< Signaled whenever a worker takes a job. */
+    ResultCache *       cache;              /**< The results of earlier submissions or NULL. */
+    EulerianMemory      memory;             /**< Where the solvers of the workers keep their graphs. */
+} JobQueue;
+
+
+/**
+ * @brief A client connection. The reader thread receives requests, the writer thread sends the responses in order.
+ */
+struct Connection
+{
+    int                 fd;                 /**< The socket of the connection. */
+    JobQueue *          queue;              /**< Where the requests go. */
+    size_t              maxRequestSize;     /**< Requests larger than this are refused. */
+    Job *               first;              /**< The oldest job without a response. */
+    Job *               last;               /**< The newest job. */
+    bool                closed;             /**< true, if the reader is done and no more jobs will come. */
+    pthread_mutex_t     mutex;              /**< Protects the job list, the done flags and the closed flag. */
+    pthread_cond_t      changed;            /**< Signaled whenever a job is added or done, or the reader is done. */
+    char                buffer[ SERVER_READ_BUFFER_SIZE ];  /**< Received bytes which haven't been used yet. */
+    size_t              bufferStart;        /**< The first unused byte in the buffer. */
+    size_t              bufferEnd;          /**< One past the last received byte in the buffer. */
+};
+
+
+/**
+ * @brief Set by the signal handler to stop accepting connections.
+ */
+static volatile sig_atomic_t stopRequested = 0;
+
+
+static void requestStop( int signalNum )
+{
+    (void) signalNum;
+    stopRequested = 1;
+    return;
+}
+
+
+/**
+ * @return The time of a monotonic clock in nanoseconds.
+ */
+static long long now( void )
+{
+    struct timespec time;
+    clock_gettime( CLOCK_MONOTONIC, &time );
+    return (long long) time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+
+/**
+ * @brief Receives more bytes into the buffer of the connection, moving the unused ones to the front first.
+ * @return false, if the connection has been closed or failed.
+ */
+static bool connection_fill( Connection *connection )
+{
+    if( connection->bufferStart > 0 )
+    {
+        memmove( connection->buffer, connection->buffer + connection->bufferStart,
+                 connection->bufferEnd - connection->bufferStart );
+        connection->bufferEnd -= connection->bufferStart;
+        connection->bufferStart = 0;
+    }
+
+    while( true )
+    {
+        ssize_t bytesRead = read( connection->fd, connection->buffer + connection->bufferEnd,
+                                  SERVER_READ_BUFFER_SIZE - connection->bufferEnd );
+        if( bytesRead > 0 )
+        {
+            connection->bufferEnd += (size_t) bytesRead;
+            return true;
+        }
+        if( bytesRead == 0 || errno != EINTR )
+            return false;
+    }
+}
+
+
+/**
+ * @brief Receives and drops everything until the client closes the connection.
+ * Closing a socket with unread data resets it, and the client would lose the responses which haven't been read yet.
+ */
+static void connection_drain( Connection *connection )
+{
+    do
+    {
+        connection->bufferStart = 0;
+        connection->bufferEnd = 0;
+    }
+    while( connection_fill( connection ));
+    return;
+}
+
+
+/**
+ * @brief Reads an unsigned decimal number after optional blanks. Unlike sscanf, this refuses a sign.
+ * @return false, if there's no digit or the number doesn't fit.
+ */
+static bool parseUnsigned( char **cursor, unsigned long long *value )
+{
+    char *start = *cursor;
+    while( *start == ' ' || *start == '\t' )
+        start++;
+
+    if( (unsigned) ( *start - '0' ) > 9 )
+        return false;
+
+    errno = 0;
+    *value = strtoull( start, cursor, 10 );
+    return errno != ERANGE;
+}
+
+
+/**
+ * @brief Receives a request header "<id> <size>\n".
+ * @return Whether the header is valid. The id is set as well if the request is too large.
+ */
+static HeaderResult connection_readHeader( Connection *connection, unsigned long long *id, size_t *size )
+{
+    // An invalid header gets no id.
+    *id = 0;
+
+    // The header must fit into the buffer, which is much more than two numbers need.
+    char *lineEnd;
+    while(( lineEnd = (char *) memchr( connection->buffer + connection->bufferStart, '\n',
+                                       connection->bufferEnd - connection->bufferStart )) == NULL )
+    {
+        if( connection->bufferEnd - connection->bufferStart == SERVER_READ_BUFFER_SIZE )
+            return HEADER_INVALID;
+        if( !connection_fill( connection ))
+            return HEADER_END;
+    }
+
+    *lineEnd = '\0';
+    char *line = connection->buffer + connection->bufferStart;
+    connection->bufferStart = (size_t) ( lineEnd - connection->buffer ) + 1;
+
+    unsigned long long requestId, requestSize;
+    char *cursor = line;
+    if( !parseUnsigned( &cursor, &requestId ) || ( *cursor != ' ' && *cursor != '\t' ) ||
+        !parseUnsigned( &cursor, &requestSize ) || *cursor != '\0' )
+        return HEADER_INVALID;
+
+    *id = requestId;
+
+    if( requestSize > connection->maxRequestSize )
+        return HEADER_TOO_LARGE;
+
+    *size = (size_t) requestSize;
+    return HEADER_OK;
+}
+
+
+/**
+ * @brief Receives exactly the declared number of bytes of request data into the payload of a job.
+ * The payload grows as the data arrives, so the declared size alone doesn't make the server reserve any memory.
+ * @return false, if the connection ended before or the payload couldn't grow. In the latter case the job is refused.
+ */
+static bool connection_readPayload( Connection *connection, Job *job )
+{
+    // Binary graphs are used in place, and malloc aligns the payload for that.
+    size_t capacity = job->size < SERVER_READ_BUFFER_SIZE ? job->size : SERVER_READ_BUFFER_SIZE;
+    job->payload = (char *) malloc( capacity > 0 ? capacity : 1 );
+    if( job->payload == NULL )
+    {
+        job->refusal = "Nicht genug Speicher";
+        return false;
+    }
+
+    size_t received = 0;
+    while( received < job->size )
+    {
+        if( connection->bufferStart == connection->bufferEnd && !connection_fill( connection ))
+            return false;
+
+        size_t available = connection->bufferEnd - connection->bufferStart;
+        size_t count = available < job->size - received ? available : job->size - received;
+
+        // Double the capacity if the data doesn't fit, but never beyond the declared size.
+        if( received + count > capacity )
+        {
+            size_t newCapacity = 2 * capacity < job->size ? 2 * capacity : job->size;
+            char *payload = (char *) realloc( job->payload, newCapacity );
+            if( payload == NULL )
+            {
+                job->refusal = "Nicht genug Speicher";
+                return false;
+            }
+            job->payload = payload;
+            capacity = newCapacity;
+        }
+
+        memcpy( job->payload + received, connection->buffer + connection->bufferStart, count );
+        connection->bufferStart += count;
+        received += count;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Waits until the queue has room for another job and takes that room.
+ * Since the payload is only received afterwards, a full queue makes the clients wait instead of the server's memory grow.
+ */
+static void jobQueue_reserve( JobQueue *queue )
+{
+    pthread_mutex_lock( &queue->mutex );
+    while( queue->count >= queue->capacity )
+        pthread_cond_wait( &queue->jobTaken, &queue->mutex );
+    queue->count++;
+    pthread_mutex_unlock( &queue->mutex );
+    return;
+}
+
+
+/**
+ * @brief Gives back the room of a job which won't be queued after all.
+ */
+static void jobQueue_cancel( JobQueue *queue )
+{
+    pthread_mutex_lock( &queue->mutex );
+    queue->count--;
+    pthread_cond_signal( &queue->jobTaken );
+    pthread_mutex_unlock( &queue->mutex );
+    return;
+}
+
+
+/**
+ * @brief Queues a job whose room has been reserved.
+ */
+static void jobQueue_push( JobQueue *queue, Job *job )
+{
+    pthread_mutex_lock( &queue->mutex );
+    if( queue->last != NULL )
+        queue->last->nextQueued = job;
+    else
+        queue->first = job;
+    queue->last = job;
+    pthread_cond_signal( &queue->jobQueued );
+    pthread_mutex_unlock( &queue->mutex );
+    return;
+}
+
+
+/**
+ * @brief Appends a job to the jobs of the connection, which the writer answers in request order.
+ */
+static void connection_addJob( Connection *connection, Job *job )
+{
+    pthread_mutex_lock( &connection->mutex );
+    if( connection->last != NULL )
+        connection->last->nextInConnection = job;
+    else
+        connection->first = job;
+    connection->last = job;
+    pthread_cond_broadcast( &connection->changed );
+    pthread_mutex_unlock( &connection->mutex );
+    return;
+}
+
+
+/**
+ * @brief Receives requests until the client closes the connection and hands them to the workers.
+ */
+static void *connection_read( void *argument )
+{
+    Connection *connection = (Connection *) argument;
+
+    unsigned long long id = 0;
+    size_t size = 0;
+    while( true )
+    {
+        HeaderResult header = connection_readHeader( connection, &id, &size );
+        if( header == HEADER_END )
+            break;
+
+        // Without a job, there's no way to answer, so the connection is just closed.
+        Job *job = (Job *) calloc( 1, sizeof( Job ));
+        if( job == NULL )
+            break;
+
+        job->connection = connection;
+        job->id = id;
+        job->size = size;
+
+        if( header == HEADER_INVALID )
+            job->refusal = "Ungueltige Anfrage";
+        else if( header == HEADER_TOO_LARGE )
+            job->refusal = "Anfrage zu gross";
+
+        if( job->refusal == NULL )
+        {
+            jobQueue_reserve( connection->queue );
+
+            if( !connection_readPayload( connection, job ))
+            {
+                jobQueue_cancel( connection->queue );
+                free( job->payload );
+                job->payload = NULL;
+
+                if( job->refusal == NULL )
+                {
+                    free( job );
+                    break;
+                }
+            }
+        }
+
+        job->receivedAt = now();
+
+        // A refused request is answered right away, and the rest of the connection can't be trusted anymore.
+        if( job->refusal != NULL )
+        {
+            job->startedAt = job->receivedAt;
+            job->loadedAt = job->receivedAt;
+            job->finishedAt = job->receivedAt;
+            job->done = true;
+            connection_addJob( connection, job );
+            connection_drain( connection );
+            break;
+        }
+
+        // The writer needs the jobs in request order, the workers take them in any order.
+        connection_addJob( connection, job );
+        jobQueue_push( connection->queue, job );
+    }
+
+    pthread_mutex_lock( &connection->mutex );
+    connection->closed = true;
+    pthread_cond_broadcast( &connection->changed );
+    pthread_mutex_unlock( &connection->mutex );
+
+    return NULL;
+}
+
+
+/**
+ * @brief Writes the response line of a job.
+ */
+static void writeResponse( OutputWriter *output, Job *job )
+{
+    char stats[ 128 ];
+    snprintf( stats, sizeof( stats ), "%llu %lld %lld %lld %lld ", job->id,
+              ( job->startedAt - job->receivedAt ) / 1000, ( job->loadedAt - job->startedAt ) / 1000,
+              ( job->finishedAt - job->loadedAt ) / 1000, ( job->finishedAt - job->receivedAt ) / 1000 );
+    outputWriter_writeString( output, stats );
+
+    if( job->refusal != NULL )
+    {
+        outputWriter_writeString( output, job->refusal );
+    }
+    else if( job->status == EULERIAN_OK )
+    {
+        size_t position;
+        for( position = 0; position < job->length; position++ )
+        {
+            outputWriter_writeInt( output, job->vertices[ position ] );
+            outputWriter_writeChar( output, ' ' );
+        }
+    }
+    else if( job->status == EULERIAN_NO_PATH )
+    {
+        outputWriter_writeString( output, "-1" );
+    }
+    else
+    {
+        outputWriter_writeString( output, "Ungueltiges Eingabeformat" );
+        if( job->errorLine > 0 )
+        {
+            outputWriter_writeString( output, " (Zeile " );
+            outputWriter_writeInt( output, job->errorLine );
+            outputWriter_writeString( output, ", Spalte " );
+            outputWriter_writeInt( output, job->errorColumn );
+            outputWriter_writeString( output, ": " );
+            outputWriter_writeString( output, job->errorMessage );
+            outputWriter_writeChar( output, ')' );
+        }
+    }
+
+    outputWriter_writeChar( output, '\n' );
+    return;
+}
+
+
+/**
+ * @brief Sends the responses of a connection in request order. When the reader is done and all responses are sent,
+ * the connection is closed and freed.
+ */
+static void *connection_write( void *argument )
+{
+    Connection *connection = (Connection *) argument;
+    OutputWriter *output = outputWriter_new( connection->fd );
+
+    pthread_mutex_lock( &connection->mutex );
+    while( true )
+    {
+        while( connection->first == NULL && !connection->closed )
+            pthread_cond_wait( &connection->changed, &connection->mutex );
+
+        if( connection->first == NULL )
+            break;
+
+        Job *job = connection->first;
+        while( !job->done )
+            pthread_cond_wait( &connection->changed, &connection->mutex );
+
+        connection->first = job->nextInConnection;
+        if( connection->first == NULL )
+            connection->last = NULL;
+
+        // If the next response isn't ready yet, the client gets this one right away.
+        // Otherwise pipelined responses are sent together.
+        bool flush = ( connection->first == NULL || !connection->first->done );
+        pthread_mutex_unlock( &connection->mutex );
+
+        writeResponse( output, job );
+        if( flush )
+            outputWriter_flush( output );
+
+        free( job->vertices );
+        free( job );
+
+        pthread_mutex_lock( &connection->mutex );
+    }
+    pthread_mutex_unlock( &connection->mutex );
+
+    outputWriter_destroy( output );
+    close( connection->fd );
+    pthread_cond_destroy( &connection->changed );
+    pthread_mutex_destroy( &connection->mutex );
+    free( connection );
+
+    return NULL;
+}
+
+
+/**
+ * @brief Loads and solves the graph of a job with the solver of the worker, unless the cache knows the result.
+ */
+static void solveJob( EulerianSolver *solver, ResultCache *cache, Job *job )
+{
+    ResultCacheKey key;
+    if( cache != NULL )
+    {
+        key = resultCache_hash( job->payload, job->size );
+        if( resultCache_lookup( cache, key, &job->status, &job->vertices, &job->length ))
+        {
+            free( job->payload );
+            job->payload = NULL;
+            job->loadedAt = now();
+            return;
+        }
+    }
+
+    job->status = eulerianSolver_loadBuffer( solver, job->payload, job->size );
+    job->loadedAt = now();
+
+    // The graph data isn't needed anymore once it's loaded.
+    free( job->payload );
+    job->payload = NULL;
+
+    if( job->status != EULERIAN_OK )
+    {
+        job->errorMessage = eulerianSolver_getError( solver, &job->errorLine, &job->errorColumn );
+        return;
+    }
+
+    size_t length = eulerianSolver_getPathLength( solver );
+    job->vertices = (int *) malloc(( length > 0 ? length : 1 ) * sizeof( int ));
+    if( job->vertices == NULL )
+    {
+        job->refusal = "Nicht genug Speicher";
+        return;
+    }
+
+    job->status = eulerianSolver_solve( solver, job->vertices, length, &job->length );
+
+    if( cache != NULL )
+        resultCache_store( cache, key, job->status, job->vertices, job->length );
+
+    return;
+}
+
+
+/**
+ * @brief The loop of a worker thread: take the oldest job of any connection and solve it.
+ */
+static void *worker_run( void *argument )
+{
+    JobQueue *queue = (JobQueue *) argument;
+    EulerianSolver *solver = eulerianSolver_new();
+    eulerianSolver_setMemory( solver, queue->memory );
+
+    while( true )
+    {
+        pthread_mutex_lock( &queue->mutex );
+        while( queue->first == NULL )
+            pthread_cond_wait( &queue->jobQueued, &queue->mutex );
+
+        Job *job = queue->first;
+        queue->first = job->nextQueued;
+        if( queue->first == NULL )
+            queue->last = NULL;
+        queue->count--;
+        pthread_cond_signal( &queue->jobTaken );
+        pthread_mutex_unlock( &queue->mutex );
+
+        job->startedAt = now();
+        solveJob( solver, queue->cache, job );
+        job->finishedAt = now();
+
+        Connection *connection = job->connection;
+        pthread_mutex_lock( &connection->mutex );
+        job->done = true;
+        pthread_cond_broadcast( &connection->changed );
+        pthread_mutex_unlock( &connection->mutex );
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Starts a detached thread.
+ */
+static void startThread( void *(*function)( void * ), void *argument )
+{
+    pthread_t thread;
+    pthread_attr_t attributes;
+    pthread_attr_init( &attributes );
+    pthread_attr_setdetachstate( &attributes, PTHREAD_CREATE_DETACHED );
+
+    int result = pthread_create( &thread, &attributes, function, argument );
+    assert( result == 0 );
+    (void) result;
+
+    pthread_attr_destroy( &attributes );
+    return;
+}
+
+
+bool server_run( const char *socketPath, int workerCount, size_t maxRequestSize, ResultCache *cache, EulerianMemory memory )
+{
+    struct sockaddr_un address;
+    memset( &address, 0, sizeof( address ));
+    address.sun_family = AF_UNIX;
+    if( strlen( socketPath ) >= sizeof( address.sun_path ))
+        return false;
+    strcpy( address.sun_path, socketPath );
+
+    int listener = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if( listener < 0 )
+        return false;
+
+    unlink( socketPath );
+    if( bind( listener, (struct sockaddr *) &address, sizeof( address )) != 0 || listen( listener, 64 ) != 0 )
+    {
+        close( listener );
+        return false;
+    }
+
+    // Clients which go away must not kill the server, and the signals only interrupt 'accept()'.
+    signal( SIGPIPE, SIG_IGN );
+
+    struct sigaction stopAction;
+    memset( &stopAction, 0, sizeof( stopAction ));
+    stopAction.sa_handler = requestStop;
+    sigemptyset( &stopAction.sa_mask );
+    sigaction( SIGINT, &stopAction, NULL );
+    sigaction( SIGTERM, &stopAction, NULL );
+
+    // The queue lives as long as the process, since the detached threads may still use it.
+    JobQueue *queue = (JobQueue *) calloc( 1, sizeof( JobQueue ));
+    assert( queue != NULL );
+    pthread_mutex_init( &queue->mutex, NULL );
+    pthread_cond_init( &queue->jobQueued, NULL );
+    pthread_cond_init( &queue->jobTaken, NULL );
+    queue->cache = cache;
+    queue->memory = memory;
+
+    if( workerCount < 1 )
+        workerCount = 1;
+    queue->capacity = workerCount * SERVER_QUEUED_JOBS_PER_WORKER;
+
+    if( maxRequestSize == 0 )
+        maxRequestSize = SERVER_DEFAULT_MAX_REQUEST_SIZE;
+
+    int workerNum;
+    for( workerNum = 0; workerNum < workerCount; workerNum++ )
+        startThread( worker_run, queue );
+
+    while( !stopRequested )
+    {
+        int fd = accept( listener, NULL, NULL );
+        if( fd < 0 )
+            continue;
+
+        // Without memory for the connection, the client is turned away.
+        Connection *connection = (Connection *) malloc( sizeof( Connection ));
+        if( connection == NULL )
+        {
+            close( fd );
+            continue;
+        }
+
+        connection->fd = fd;
+        connection->queue = queue;
+        connection->maxRequestSize = maxRequestSize;
+        connection->first = NULL;
+        connection->last = NULL;
+        connection->closed = false;
+        connection->bufferStart = 0;
+        connection->bufferEnd = 0;
+        pthread_mutex_init( &connection->mutex, NULL );
+        pthread_cond_init( &connection->changed, NULL );
+
+        startThread( connection_read, connection );
+        startThread( connection_write, connection );
+    }
+
+    close( listener );
+    unlink( socketPath );
+
+    return true;
+}
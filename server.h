@@ -0,0 +1,68 @@
+/**
+ * @file server.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief Keeps the solver resident and answers graph submissions over a Unix domain socket.
+ */
+
+
+#ifndef SERVER
+#define SERVER
+
+
+#include "basic.h"
+#include "resultcache.h"
+#include "eulerian.h"
+
+
+/**
+ * @brief The largest request a server accepts by default: 64 MiB.
+ */
+#define SERVER_DEFAULT_MAX_REQUEST_SIZE     ( (size_t) 64 << 20 )
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Listens on a Unix domain socket and solves the graphs which clients submit, until SIGINT or SIGTERM.
+ *
+ * A request is a header line "<id> <size>\n" followed by exactly size bytes of graph data,
+ * either in the text format or the contents of a binary graph file. The id is an unsigned decimal number
+ * chosen by the client. Clients may send many requests without waiting for the responses (pipelining).
+ *
+ * Every request is answered by one line, in request order per connection:
+ * "<id> <queue us> <load us> <solve us> <total us> <result>\n".
+ * The times are in microseconds: waiting for a worker, loading the graph, finding the path,
+ * and everything from receiving the request to finishing the result. The result looks like the output
+ * of a single run: the vertex numbers of the path each followed by a space, "-1" if there is none,
+ * or the reason why the graph couldn't be loaded.
+ *
+ * A request whose header is invalid or whose size exceeds the limit is answered with "Ungueltige Anfrage" or
+ * "Anfrage zu gross" instead of a result. The server ignores the rest of such a connection and closes it
+ * once the client has closed its side. The id of an invalid header is 0.
+ * A request the server has no memory for is answered with "Nicht genug Speicher".
+ * The payload is received into a buffer which grows as the data arrives. Each worker has room for a few waiting jobs;
+ * when all of it is taken, the server stops reading requests until a worker is free.
+ *
+ * The requests of all connections are solved by a fixed pool of worker threads, each with a solver of its own.
+ * With a cache, a graph which has been submitted before isn't loaded or solved again. Its load time is the time
+ * for hashing and decompressing the cached path, and its solve time is 0.
+ * @param socketPath The path of the socket. An existing socket file is replaced.
+ * @param workerCount The number of worker threads.
+ * @param maxRequestSize Requests with more bytes of graph data are refused. 0 means SERVER_DEFAULT_MAX_REQUEST_SIZE.
+ * @param cache The cache of results or NULL.
+ * @param memory Where the solvers of the workers keep their graphs.
+ * @return false, if the socket couldn't be set up.
+ */
+bool server_run( const char *socketPath, int workerCount, size_t maxRequestSize, ResultCache *cache, EulerianMemory memory );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // SERVER
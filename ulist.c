@@ -0,0 +1,187 @@
+#include "ulist.h"
+#include "string.h"
+#include "instrument.h"
+
+
+/**
+ * @return The number of bytes of a chunk of the list with the given capacity.
+ */
+static size_t chunkSize( UList *list, int capacity )
+{
+    return sizeof( UListChunk ) + (size_t) capacity * list->slotSize;
+}
+
+
+UList *uList_new( int elementSize )
+{
+    return uList_newWithAllocator( elementSize, NULL );
+}
+
+
+UList *uList_newWithAllocator( int elementSize, const Allocator *allocator )
+{
+    if( allocator == NULL )
+        allocator = allocator_getDefault();
+
+    UList *list = (UList *) allocator_allocate( allocator, sizeof( UList ));
+
+    list->dataSize = elementSize;
+
+    // Round up so that every slot stays aligned like a pointer.
+    list->slotSize = ( elementSize + sizeof( Data ) - 1 ) / sizeof( Data ) * sizeof( Data );
+
+    list->listSize = 0;
+    list->first = NULL;
+    list->last = NULL;
+    list->allocator = allocator;
+
+    return list;
+}
+
+
+void uList_destroy( UList *list )
+{
+    allocator_release( list->allocator, list, sizeof( UList ));
+    return;
+}
+
+
+void uList_destroyAll( UList *list )
+{
+    UListChunk *chunk = list->first;
+    while( chunk != NULL )
+    {
+        UListChunk *next = chunk->next;
+        INSTRUMENT_COUNT( INSTRUMENT_CHUNKS_FREED );
+        allocator_release( list->allocator, chunk, chunkSize( list, chunk->capacity ));
+        chunk = next;
+    }
+
+    allocator_release( list->allocator, list, sizeof( UList ));
+    return;
+}
+
+
+inline int uList_getSize( UList *list )
+{
+    return list->listSize;
+}
+
+
+inline bool uList_isEmpty( UList *list )
+{
+    return list->listSize == 0;
+}
+
+
+void uList_append( UList *list, Data data )
+{
+    UListChunk *last = list->last;
+
+    // Start a new chunk if there's no room behind the last element.
+    // Each new chunk is twice as large as the last one, until the maximum capacity is reached.
+    if( last == NULL || last->used == last->capacity )
+    {
+        int capacity = ULIST_MIN_CHUNK_CAPACITY;
+        if( last != NULL )
+            capacity = last->capacity * 2;
+        if( capacity > ULIST_MAX_CHUNK_CAPACITY )
+            capacity = ULIST_MAX_CHUNK_CAPACITY;
+
+        last = uList_insertChunk( list, capacity, last, NULL );
+    }
+
+    int index = last->used;
+    memcpy( uList_getSlot( list, last, index ), data, list->dataSize );
+    last->used++;
+    last->liveCount++;
+    last->liveMask |= (uint64_t) 1 << index;
+
+    list->listSize++;
+
+    return;
+}
+
+
+Data uList_get( UList *list, int i )
+{
+    assert( i < list->listSize );
+    assert( i >= 0 );
+
+    // Skip whole chunks first.
+    UListChunk *chunk = list->first;
+    while( i >= chunk->liveCount )
+    {
+        i -= chunk->liveCount;
+        chunk = chunk->next;
+    }
+
+    // Then find the i-th element inside the chunk.
+    int index = 0;
+    while( true )
+    {
+        if( chunk->liveMask & ( (uint64_t) 1 << index ))
+        {
+            if( i == 0 )
+                break;
+            i--;
+        }
+        index++;
+    }
+
+    return uList_getSlot( list, chunk, index );
+}
+
+
+UListChunk *uList_insertChunk( UList *list, int capacity, UListChunk *prev, UListChunk *next )
+{
+    assert( capacity > 0 && capacity <= ULIST_MAX_CHUNK_CAPACITY );
+
+    UListChunk *chunk = (UListChunk *) allocator_allocate( list->allocator, chunkSize( list, capacity ));
+    INSTRUMENT_COUNT( INSTRUMENT_CHUNKS_ALLOCATED );
+
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->liveCount = 0;
+    chunk->liveMask = 0;
+
+    // Link the chunk.
+    chunk->prev = prev;
+    chunk->next = next;
+
+    if( prev != NULL )
+        prev->next = chunk;
+    else
+        list->first = chunk;
+
+    if( next != NULL )
+        next->prev = chunk;
+    else
+        list->last = chunk;
+
+    return chunk;
+}
+
+
+void uList_removeChunk( UList *list, UListChunk *chunk )
+{
+    if( chunk->prev != NULL )
+        chunk->prev->next = chunk->next;
+    else
+        list->first = chunk->next;
+
+    if( chunk->next != NULL )
+        chunk->next->prev = chunk->prev;
+    else
+        list->last = chunk->prev;
+
+    INSTRUMENT_COUNT( INSTRUMENT_CHUNKS_FREED );
+    allocator_release( list->allocator, chunk, chunkSize( list, chunk->capacity ));
+    return;
+}
+
+
+Data uList_getSlot( UList *list, UListChunk *chunk, int index )
+{
+    return (Data) ( (char *) chunk->slots + (size_t) index * list->slotSize );
+}
@@ -0,0 +1,181 @@
+/**
+ * @file ulist.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A generic unrolled doubly linked list.
+ */
+
+#ifndef ULIST
+#define ULIST
+
+
+#include "stdint.h"
+#include "basic.h"
+#include "allocator.h"
+
+
+/**
+ * @brief The smallest number of elements a chunk can hold.
+ */
+#define ULIST_MIN_CHUNK_CAPACITY    4
+
+
+/**
+ * @brief The largest number of elements a chunk can hold. It must not exceed the number of bits of a live mask.
+ */
+#define ULIST_MAX_CHUNK_CAPACITY    64
+
+
+/**
+ * @brief Selects how a list of elements is stored.
+ */
+typedef enum
+{
+    LIST_BACKEND_LINKED,        /**< One DList node per element. */
+    LIST_BACKEND_UNROLLED       /**< Many elements per UList chunk. */
+} ListBackend;
+
+
+typedef struct UListChunk UListChunk;
+
+/**
+ * @brief A chunk of an unrolled list. The elements are stored inline right behind the chunk.
+ *
+ * The slots of a chunk are filled from the front. Removing an element leaves a hole
+ * so the positions of the other elements don't change. A chunk is freed as soon as its last element is removed.
+ */
+struct UListChunk
+{
+    UListChunk *    prev;           /**< The previous chunk. */
+    UListChunk *    next;           /**< The next chunk. */
+    int             capacity;       /**< The number of slots. */
+    int             used;           /**< The number of slots which have been filled so far (including holes). */
+    int             liveCount;      /**< The number of slots which contain an element. */
+    uint64_t        liveMask;       /**< Bit i is set, if slot i contains an element. */
+    Data            slots[];        /**< The elements as raw memory. */
+};
+
+
+/**
+ * @brief The data structure of a generic unrolled doubly linked list.
+ *
+ * Instead of one node per element, the list is made up of chunks which hold many elements each.
+ * The elements are copied into the chunks, so walking the list touches far fewer cache lines.
+ * The list stores its data inline like a DList created with 'dList_newInline()'.
+ *
+ * Unlike DList, there're no discrete begin and end chunks: An empty list has no chunks at all.
+ * New chunks start small and double their capacity up to ULIST_MAX_CHUNK_CAPACITY, so short lists stay small.
+ */
+typedef struct
+{
+    int             dataSize;       /**< The size of the data stored in each slot. */
+    int             slotSize;       /**< The distance between two slots of a chunk. */
+    int             listSize;       /**< The number of elements in the list. */
+    UListChunk *    first;          /**< The first chunk or NULL if the list is empty. */
+    UListChunk *    last;           /**< The last chunk or NULL if the list is empty. */
+    const Allocator *allocator;     /**< The allocator of the list and its chunks. */
+} UList;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new empty list.
+ * @param elementSize The size of the data stored in each slot.
+ * @return A pointer to the created list.
+ */
+UList *uList_new( int elementSize );
+
+
+/**
+ * @brief Allocates and initializes a new empty list which takes the list and its chunks from the given allocator.
+ * @param elementSize The size of the data stored in each slot.
+ * @param allocator The allocator or NULL for the default allocator.
+ * @return A pointer to the created list.
+ */
+UList *uList_newWithAllocator( int elementSize, const Allocator *allocator );
+
+
+/**
+ * @brief Simply frees the pointer to the list.
+ * @param list
+ *
+ * @attention This does not free the chunks!
+ */
+void uList_destroy( UList *list );
+
+
+/**
+ * @brief Completely destroys and frees the list including its chunks and therefore its data.
+ * @param list
+ */
+void uList_destroyAll( UList *list );
+
+
+/**
+ * @param list
+ * @return The number of elements in the list.
+ */
+int uList_getSize( UList *list );
+
+
+/**
+ * @param list
+ * @return true, if there're no elements in the list.
+ */
+bool uList_isEmpty( UList *list );
+
+
+/**
+ * @brief Copies the given data behind the last element of the list.
+ * @param list
+ * @param data Points to the data to copy.
+ */
+void uList_append( UList *list, Data data );
+
+
+/**
+ * @param list
+ * @param i
+ * @return The data of the i-th element of the list (start counting at the first element).
+ */
+Data uList_get( UList *list, int i );
+
+
+/**
+ * @brief Allocates a chunk and links it into the list between two chunks. Used by the iterator functions.
+ * @param list
+ * @param capacity
+ * @param prev The chunk before the new one or NULL if it becomes the first chunk.
+ * @param next The chunk after the new one or NULL if it becomes the last chunk.
+ * @return The pointer to the new chunk.
+ */
+UListChunk *uList_insertChunk( UList *list, int capacity, UListChunk *prev, UListChunk *next );
+
+
+/**
+ * @brief Unlinks a chunk from the list and frees it. Used by the iterator functions.
+ * @param list
+ * @param chunk
+ */
+void uList_removeChunk( UList *list, UListChunk *chunk );
+
+
+/**
+ * @param list
+ * @param chunk
+ * @param index
+ * @return The data in the given slot of the chunk.
+ */
+Data uList_getSlot( UList *list, UListChunk *chunk, int index );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // ULIST
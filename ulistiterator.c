@@ -0,0 +1,254 @@
+#include "ulistiterator.h"
+#include "string.h"
+#include "instrument.h"
+
+
+/**
+ * @return The first slot at or after 'from' which contains an element, or -1 if there's none.
+ */
+static int findLiveSlotForward( UListChunk *chunk, int from )
+{
+    if( from >= chunk->used )
+        return -1;
+
+    uint64_t mask = chunk->liveMask >> from;
+    if( mask == 0 )
+        return -1;
+
+    return from + __builtin_ctzll( mask );
+}
+
+
+/**
+ * @return The last slot at or before 'from' which contains an element, or -1 if there's none.
+ */
+static int findLiveSlotBackward( UListChunk *chunk, int from )
+{
+    if( from < 0 )
+        return -1;
+
+    // Shifting an unsigned 2 by 63 gives 0, so 'from' = 63 keeps the whole mask.
+    uint64_t mask = chunk->liveMask & ((( (uint64_t) 2 ) << from ) - 1 );
+    if( mask == 0 )
+        return -1;
+
+    return 63 - __builtin_clzll( mask );
+}
+
+
+/**
+ * @brief Moves the elements behind the given slot into a new chunk right after the given chunk.
+ * Afterwards the given slot is the last used slot of the chunk.
+ */
+static void splitChunkAfter( UList *list, UListChunk *chunk, int index )
+{
+    int from = findLiveSlotForward( chunk, index + 1 );
+    if( from >= 0 )
+    {
+        UListChunk *tail = uList_insertChunk( list, chunk->capacity, chunk, chunk->next );
+
+        int slot;
+        for( slot = from; slot < chunk->used; slot++ )
+        {
+            if( !( chunk->liveMask & ( (uint64_t) 1 << slot )))
+                continue;
+
+            memcpy( uList_getSlot( list, tail, tail->used ), uList_getSlot( list, chunk, slot ), list->dataSize );
+            tail->liveMask |= (uint64_t) 1 << tail->used;
+            tail->used++;
+            tail->liveCount++;
+
+            chunk->liveMask &= ~( (uint64_t) 1 << slot );
+            chunk->liveCount--;
+        }
+    }
+
+    chunk->used = index + 1;
+    return;
+}
+
+
+void uListIterator_toFirst( UListIterator *iterator, UList *list )
+{
+    // Chunks are freed as soon as they're empty, so the first chunk has an element.
+    iterator->chunk = list->first;
+    if( iterator->chunk != NULL )
+        iterator->index = findLiveSlotForward( iterator->chunk, 0 );
+    return;
+}
+
+
+void uListIterator_toLast( UListIterator *iterator, UList *list )
+{
+    iterator->chunk = list->last;
+    if( iterator->chunk != NULL )
+        iterator->index = findLiveSlotBackward( iterator->chunk, iterator->chunk->used - 1 );
+    return;
+}
+
+
+void uListIterator_increment( UListIterator *iterator )
+{
+    int index = findLiveSlotForward( iterator->chunk, iterator->index + 1 );
+    if( index < 0 )
+    {
+        iterator->chunk = iterator->chunk->next;
+        if( iterator->chunk != NULL )
+            index = findLiveSlotForward( iterator->chunk, 0 );
+    }
+
+    iterator->index = index;
+    return;
+}
+
+
+void uListIterator_decrement( UListIterator *iterator )
+{
+    int index = findLiveSlotBackward( iterator->chunk, iterator->index - 1 );
+    if( index < 0 )
+    {
+        iterator->chunk = iterator->chunk->prev;
+        if( iterator->chunk != NULL )
+            index = findLiveSlotBackward( iterator->chunk, iterator->chunk->used - 1 );
+    }
+
+    iterator->index = index;
+    return;
+}
+
+
+bool uListIterator_isAtEnd( UListIterator *iterator )
+{
+    return iterator->chunk == NULL;
+}
+
+
+Data uListIterator_get( UListIterator *iterator, UList *list )
+{
+    return uList_getSlot( list, iterator->chunk, iterator->index );
+}
+
+
+void uListIterator_insertAfter( UListIterator *iterator, UList *list, Data data )
+{
+    assert( !uListIterator_isAtEnd( iterator ));
+
+    UListChunk *chunk = iterator->chunk;
+
+    // Make the iterator's slot the last used one, so the new element can go right behind it.
+    if( iterator->index != chunk->used - 1 )
+        splitChunkAfter( list, chunk, iterator->index );
+
+    // If the chunk is full, the new element gets a chunk of its own.
+    if( chunk->used == chunk->capacity )
+        chunk = uList_insertChunk( list, ULIST_MIN_CHUNK_CAPACITY, chunk, chunk->next );
+
+    int index = chunk->used;
+    memcpy( uList_getSlot( list, chunk, index ), data, list->dataSize );
+    chunk->used++;
+    chunk->liveCount++;
+    chunk->liveMask |= (uint64_t) 1 << index;
+
+    list->listSize++;
+
+    return;
+}
+
+
+void uListIterator_destroy( UListIterator *iterator, UList *list )
+{
+    assert( !uListIterator_isAtEnd( iterator ));
+
+    UListChunk *chunk = iterator->chunk;
+    chunk->liveMask &= ~( (uint64_t) 1 << iterator->index );
+    chunk->liveCount--;
+    list->listSize--;
+
+    // Give trailing holes back so the slots can be filled again.
+    while( chunk->used > 0 && !( chunk->liveMask & ( (uint64_t) 1 << ( chunk->used - 1 ))))
+        chunk->used--;
+
+    if( chunk->liveCount == 0 )
+        uList_removeChunk( list, chunk );
+
+    return;
+}
+
+
+Data uListIterator_search( UListIterator *iterator, UList *list, Comparator *comparator )
+{
+    // Start searching at the current element.
+    while( !uListIterator_isAtEnd( iterator ))
+    {
+        Data compareData = uListIterator_get( iterator, list );
+
+        // If the condition is true we've found the element.
+        if( comparator_compare( comparator, compareData ))
+            return compareData;
+
+        uListIterator_increment( iterator );
+    }
+
+    return NULL;
+}
+
+
+void uListIterator_merge( UListIterator *iterator, UList *mainList, UList *mergeList )
+{
+    assert( !uListIterator_isAtEnd( iterator ));
+    assert( mainList->dataSize == mergeList->dataSize );
+
+    // The chunks change their list, so both lists must take them from the same allocator.
+    assert( mainList->allocator == mergeList->allocator );
+
+    // Nothing to do if the merge list is empty.
+    if( uList_isEmpty( mergeList ))
+        return;
+
+    INSTRUMENT_COUNT( INSTRUMENT_MERGES );
+
+    // Split the chunk so that the iterator's element is the last one in it.
+    UListChunk *chunk = iterator->chunk;
+    splitChunkAfter( mainList, chunk, iterator->index );
+
+    // Remove the iterator's element. The first element of the merge list acts as its replacement.
+    chunk->liveMask &= ~( (uint64_t) 1 << iterator->index );
+    chunk->liveCount--;
+    chunk->used = iterator->index;
+
+    UListChunk *prev = chunk;
+    UListChunk *next = chunk->next;
+    if( chunk->liveCount == 0 )
+    {
+        prev = chunk->prev;
+        uList_removeChunk( mainList, chunk );
+    }
+
+    // Link the chunks of the merge list in between.
+    UListChunk *first = mergeList->first;
+    UListChunk *last = mergeList->last;
+
+    first->prev = prev;
+    if( prev != NULL )
+        prev->next = first;
+    else
+        mainList->first = first;
+
+    last->next = next;
+    if( next != NULL )
+        next->prev = last;
+    else
+        mainList->last = last;
+
+    // Update the size of the main list.
+    mainList->listSize += mergeList->listSize - 1;
+
+    // The iterator's current element is the first element of the merge list now.
+    iterator->chunk = first;
+    iterator->index = findLiveSlotForward( first, 0 );
+
+    // The chunks belong to the main list now, so we only free the merge list itself.
+    uList_destroy( mergeList );
+
+    return;
+}
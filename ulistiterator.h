@@ -0,0 +1,135 @@
+/**
+ * @file ulistiterator.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A bidirectional iterator for an unrolled doubly linked list.
+ */
+
+
+#ifndef ULISTITERATOR
+#define ULISTITERATOR
+
+
+#include "basic.h"
+#include "ulist.h"
+#include "comparator.h"
+
+
+/**
+ * @brief A position in an unrolled list: a chunk and a slot inside it.
+ *
+ * Since there're no discrete begin and end chunks, an iterator which walked off the list has a NULL chunk.
+ * Removing other elements of the list does not move the element the iterator is at.
+ */
+typedef struct
+{
+    UListChunk *    chunk;      /**< The chunk of the element or NULL if the iterator is off the list. */
+    int             index;      /**< The slot of the element in the chunk. */
+} UListIterator;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Sets the iterator to the first element of the list or off the list if it is empty.
+ * @param iterator
+ * @param list
+ */
+void uListIterator_toFirst( UListIterator *iterator, UList *list );
+
+
+/**
+ * @brief Sets the iterator to the last element of the list or off the list if it is empty.
+ * @param iterator
+ * @param list
+ */
+void uListIterator_toLast( UListIterator *iterator, UList *list );
+
+
+/**
+ * @brief Sets the iterator to the next element. Behind the last element, the iterator is off the list.
+ * @param iterator
+ */
+void uListIterator_increment( UListIterator *iterator );
+
+
+/**
+ * @brief Sets the iterator to the previous element. Before the first element, the iterator is off the list.
+ * @param iterator
+ */
+void uListIterator_decrement( UListIterator *iterator );
+
+
+/**
+ * @param iterator
+ * @return true, if the iterator is off the list.
+ */
+bool uListIterator_isAtEnd( UListIterator *iterator );
+
+
+/**
+ * @param iterator
+ * @param list
+ * @return The data of the element of the iterator.
+ */
+Data uListIterator_get( UListIterator *iterator, UList *list );
+
+
+/**
+ * @brief Inserts a copy of the given data between the iterator and its next element.
+ * @param iterator
+ * @param list
+ * @param data
+ *
+ * @attention The elements behind the iterator in the same chunk may be moved to another chunk,
+ * so other iterators to them are invalid afterwards.
+ */
+void uListIterator_insertAfter( UListIterator *iterator, UList *list, Data data );
+
+
+/**
+ * @brief Removes the element of the iterator from the list.
+ * @param iterator
+ * @param list
+ *
+ * @attention You cannot use the iterator anymore after calling this function!
+ */
+void uListIterator_destroy( UListIterator *iterator, UList *list );
+
+
+/**
+ * @brief Uses a comparator object to search an element in the list.
+ * The search is incremental and starts at the current element.
+ * @param iterator
+ * @param list
+ * @param comparator
+ * @return The data of the element to search for if it finds it, else NULL.
+ * In the latter case the iterator is off the list.
+ */
+Data uListIterator_search( UListIterator *iterator, UList *list, Comparator *comparator );
+
+
+/**
+ * @brief Replaces the element of the iterator with the elements of the merge list.
+ * Apart from splitting the chunk of the iterator, the chunks of the merge list are linked in as they are,
+ * so this takes constant time.
+ * @param iterator Is set to the first merged element.
+ * @param mainList
+ * @param mergeList
+ *
+ * @attention Like 'dListIterator_merge()' this destroys the merge list.
+ * The elements behind the iterator in the same chunk are moved to another chunk,
+ * so other iterators to them are invalid afterwards.
+ */
+void uListIterator_merge( UListIterator *iterator, UList *mainList, UList *mergeList );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // ULISTITERATOR
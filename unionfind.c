@@ -0,0 +1,73 @@
+#include "unionfind.h"
+
+
+UnionFind *unionFind_new( int count )
+{
+    UnionFind *unionFind = (UnionFind *) malloc( sizeof( UnionFind ));
+    assert( unionFind != NULL );
+
+    unionFind->count = count;
+    unionFind->parents = (int *) malloc( count * sizeof( int ));
+    unionFind->ranks = (unsigned char *) calloc( count, sizeof( unsigned char ));
+    assert( count == 0 || ( unionFind->parents != NULL && unionFind->ranks != NULL ));
+
+    int element;
+    for( element = 0; element < count; element++ )
+        unionFind->parents[ element ] = element;
+
+    return unionFind;
+}
+
+
+void unionFind_destroy( UnionFind *unionFind )
+{
+    free( unionFind->parents );
+    free( unionFind->ranks );
+    free( unionFind );
+    return;
+}
+
+
+int unionFind_find( UnionFind *unionFind, int element )
+{
+    int *parents = unionFind->parents;
+
+    // Walk up to the root.
+    int root = element;
+    while( parents[ root ] != root )
+        root = parents[ root ];
+
+    // Walk up again and let every element on the way point to the root directly.
+    while( parents[ element ] != root )
+    {
+        int parent = parents[ element ];
+        parents[ element ] = root;
+        element = parent;
+    }
+
+    return root;
+}
+
+
+void unionFind_unite( UnionFind *unionFind, int element1, int element2 )
+{
+    int root1 = unionFind_find( unionFind, element1 );
+    int root2 = unionFind_find( unionFind, element2 );
+    if( root1 == root2 )
+        return;
+
+    // Hang the lower tree below the higher one, so the trees stay flat.
+    // Only trees of the same height make the result higher.
+    if( unionFind->ranks[ root1 ] < unionFind->ranks[ root2 ] )
+    {
+        unionFind->parents[ root1 ] = root2;
+    }
+    else
+    {
+        unionFind->parents[ root2 ] = root1;
+        if( unionFind->ranks[ root1 ] == unionFind->ranks[ root2 ] )
+            unionFind->ranks[ root1 ]++;
+    }
+
+    return;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file unionfind.h
+ * @author Philipp Badenhoop
+ * @date 16 Oct 2026
+ * @brief A disjoint-set forest to find the connected components of a graph while its edges are read.
+ */
+
+
+#ifndef UNIONFIND
+#define UNIONFIND
+
+
+#include "basic.h"
+
+
+/**
+ * @brief A disjoint-set forest over the numbers 0 to count - 1.
+ *
+ * Every set is a tree whose root represents it. Uniting two sets hangs the root with the smaller rank
+ * below the other one (union by rank), and finding a root points every visited element right to it
+ * (path compression). Together, an operation takes almost constant amortized time.
+ */
+typedef struct
+{
+    int                 count;          /**< The number of elements. */
+    int *               parents;        /**< The parent of each element. A root is its own parent. */
+    unsigned char *     ranks;          /**< An upper bound of the height of each tree, only valid for roots. */
+} UnionFind;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Allocates and initializes a new union-find where every element is in a set of its own.
+ * @param count The number of elements.
+ * @return The pointer to the new union-find.
+ */
+UnionFind *unionFind_new( int count );
+
+
+/**
+ * @brief Frees the union-find and its arrays.
+ * @param unionFind
+ */
+void unionFind_destroy( UnionFind *unionFind );
+
+
+/**
+ * @param unionFind
+ * @param element
+ * @return The root of the set which contains the element.
+ */
+int unionFind_find( UnionFind *unionFind, int element );
+
+
+/**
+ * @brief Unites the sets which contain the two elements.
+ * @param unionFind
+ * @param element1
+ * @param element2
+ */
+void unionFind_unite( UnionFind *unionFind, int element1, int element2 );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // UNIONFIND